@@ -45,6 +45,59 @@ const uint8_t TRIANGLE_SEQUENCE[] = { 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4,
 const uint16_t NOISE_PERIOD[] =  { 4, 8, 16, 32, 64, 96, 128, 160, 202, 254, 380, 508, 762, 1016, 2034, 4068 };
 const uint16_t DMC_RATE[] = { 428, 380, 340, 320, 286, 254, 226, 214, 190, 160, 142, 128, 106, 84, 72, 54 };
 
+// Non-linear mixer lookup tables, built at compile time and indexed by pulse1 + pulse2 and 3 * triangle + 2 * noise + dmc
+// Pulse matches the mixer formula exactly, TND is the nesdev approximation of the three input formula - within 0.013 of it
+template<uint32_t... Index> struct MixerIndices {};
+template<uint32_t Count, uint32_t... Index> struct MakeMixerIndices : MakeMixerIndices<Count - 1, Count - 1, Index...> {};
+template<uint32_t... Index> struct MakeMixerIndices<0, Index...> { typedef MixerIndices<Index...> Type; };
+
+template<uint32_t Count> struct MixerTable
+{
+    float m_values[Count];
+};
+
+constexpr float PulseMix(uint32_t pulse)
+{
+    return pulse == 0 ? 0.f : 95.88f / ((8128.f / float(pulse)) + 100.f);
+}
+
+constexpr float TNDMix(uint32_t tnd)
+{
+    return tnd == 0 ? 0.f : 163.67f / ((24329.f / float(tnd)) + 100.f);
+}
+
+template<uint32_t... Index> constexpr MixerTable<sizeof...(Index)> BuildPulseMix(MixerIndices<Index...>)
+{
+    return {{ PulseMix(Index)... }};
+}
+
+template<uint32_t... Index> constexpr MixerTable<sizeof...(Index)> BuildTNDMix(MixerIndices<Index...>)
+{
+    return {{ TNDMix(Index)... }};
+}
+
+constexpr MixerTable<31> PULSE_MIX = BuildPulseMix(MakeMixerIndices<31>::Type());
+constexpr MixerTable<203> TND_MIX = BuildTNDMix(MakeMixerIndices<203>::Type());
+
+// NTSC CPU clock the APU is ticked at, output rate until told otherwise
+const double kCPUClockRate = 1789773.0;
+const double kDefaultSampleRate = 48000.0;
+
+// Frame counter values the frame sequencer acts on - (frameCount << 1) | halfFrame
+const uint16_t FRAME_STEPS[] = { (3728 << 1) | 1, (7456 << 1) | 1, (11185 << 1) | 1, (14914 << 1) | 0, (14914 << 1) | 1, (14915 << 1) | 0, (14915 << 1) | 1, (18640 << 1) | 1, (18641 << 1) | 0 };
+
+static bool IsFrameStep(uint16_t frameCounter)
+{
+    for(uint32_t step = 0;step < sizeof(FRAME_STEPS) / sizeof(FRAME_STEPS[0]);++step)
+    {
+        if(FRAME_STEPS[step] == frameCounter)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 APUPulseChannel::APUPulseChannel(uint16_t sweepNegateComplement)
 : m_dutyCycle(0)
 , m_lengthCounterHaltOrEnvelopeLoop(0)
@@ -247,7 +300,7 @@ void APUPulseChannel::HalfFrameTick()
     }
 }
 
-void APUPulseChannel::Tick()
+bool APUPulseChannel::Tick()
 {
     if(IsEnabled())
     {
@@ -259,8 +312,23 @@ void APUPulseChannel::Tick()
         {
             m_timer = m_timerValue + 1;
             RotateDutySequence();
+            return true;
         }
     }
+    return false;
+}
+
+uint32_t APUPulseChannel::TicksUntilClock() const
+{
+    return IsEnabled() ? uint32_t(m_timer) + 1 : kAPUTimerStopped;
+}
+
+void APUPulseChannel::SkipTicks(uint32_t ticks)
+{
+    if(IsEnabled())
+    {
+        m_timer -= uint16_t(ticks);
+    }
 }
 
 uint8_t APUPulseChannel::OutputValue() const
@@ -391,7 +459,7 @@ void APUTriangleChannel::HalfFrameTick()
     }
 }
 
-void APUTriangleChannel::Tick()
+bool APUTriangleChannel::Tick()
 {
     if(m_lengthCounter > 0 && m_linearCounter > 0)
     {
@@ -403,8 +471,23 @@ void APUTriangleChannel::Tick()
         {
             m_timer = m_timerValue + 1;
             m_sequenceIndex = (m_sequenceIndex + 1) % sizeof(TRIANGLE_SEQUENCE);
+            return true;
         }
     }
+    return false;
+}
+
+uint32_t APUTriangleChannel::TicksUntilClock() const
+{
+    return (m_lengthCounter > 0 && m_linearCounter > 0) ? uint32_t(m_timer) + 1 : kAPUTimerStopped;
+}
+
+void APUTriangleChannel::SkipTicks(uint32_t ticks)
+{
+    if(m_lengthCounter > 0 && m_linearCounter > 0)
+    {
+        m_timer -= uint16_t(ticks);
+    }
 }
 
 APUNoiseChannel::APUNoiseChannel()
@@ -532,7 +615,7 @@ void APUNoiseChannel::HalfFrameTick()
     }
 }
 
-void APUNoiseChannel::Tick()
+bool APUNoiseChannel::Tick()
 {
     if(IsEnabled())
     {
@@ -548,8 +631,23 @@ void APUNoiseChannel::Tick()
             uint16_t feedback = (m_linearFeedbackShift & 0b1) ^ ((m_linearFeedbackShift >> modeBit) & 0b1);
             m_linearFeedbackShift >>= 1;
             m_linearFeedbackShift |= feedback << 14;
+            return true;
         }
     }
+    return false;
+}
+
+uint32_t APUNoiseChannel::TicksUntilClock() const
+{
+    return IsEnabled() ? uint32_t(m_period) + 1 : kAPUTimerStopped;
+}
+
+void APUNoiseChannel::SkipTicks(uint32_t ticks)
+{
+    if(IsEnabled())
+    {
+        m_period -= uint16_t(ticks);
+    }
 }
 
 uint8_t APUNoiseChannel::OutputValue() const
@@ -687,11 +785,12 @@ void APUDMC::SetRegister(uint16_t reg, uint8_t byte)
     }
 }
 
-void APUDMC::Tick()
+bool APUDMC::Tick()
 {
     if(m_rate > 0)
     {
         m_rate = m_rate - 1;
+        return false;
     }
     else
     {
@@ -765,6 +864,30 @@ void APUDMC::Tick()
             m_sampleShiftBits >>= 1;
         }
     }
+    
+    return true;
+}
+
+uint32_t APUDMC::TicksUntilClock() const
+{
+    // Always counting
+    return uint32_t(m_rate) + 1;
+}
+
+void APUDMC::SkipTicks(uint32_t ticks)
+{
+    m_rate -= uint16_t(ticks);
+}
+
+uint32_t APUDMC::TicksUntilOutputCycle() const
+{
+    // Each clock shifts out a bit, the one after the last bit starts the next cycle
+    return TicksUntilClock() + uint32_t(m_sampleBitsRemaining) * (uint32_t(m_rateValue) + 2);
+}
+
+bool APUDMC::OutputCycleSignals() const
+{
+    return (m_IRQEnabled && m_enabled) || m_sampleLengthRemaining > 0 || (m_loop && m_enabled);
 }
 
 uint8_t APUDMC::OutputValue() const
@@ -782,9 +905,18 @@ APUNES::APUNES(SystemIOBus& bus)
 , m_dmc(bus)
 , m_frameCountMode(0)
 , m_frameInhibitIRQ(1)
+, m_syncCycle(1)
+, m_statusRead(0)
 , m_pAudioBuffer(nullptr)
-, m_audioOutDataCounter(0)
-{}
+, m_filteredSamples(0)
+, m_bOutputChanged(true)
+, m_channelOutput(0)
+, m_externalAudio(0.f)
+, m_pStemBuffer(nullptr)
+{
+    m_synth.SetRates(kCPUClockRate, kDefaultSampleRate);
+    m_filter.SetSampleRate(kDefaultSampleRate);
+}
 
 APUNES::~APUNES()
 {}
@@ -799,6 +931,8 @@ void APUNES::Load(Archive& rArchive)
     m_triangle.Load(rArchive);
     m_noise.Load(rArchive);
     m_dmc.Load(rArchive);
+    
+    m_bOutputChanged = true;
 }
 
 void APUNES::Save(Archive& rArchive) const
@@ -815,32 +949,100 @@ void APUNES::Save(Archive& rArchive) const
 
 float APUNES::OutputValue()
 {
-    float fPulse1 = m_pulse1.OutputValue();
-    float fPulse2 = m_pulse2.OutputValue();
-    float fTriangle = m_triangle.OutputValue();
-    float fNoise = m_noise.OutputValue();
-    float fDMC = m_dmc.OutputValue();
-
-#if 0
-    // Fast linear
-    float fPulse = 0.00752f * (fPulse1 + fPulse2);
-    float fTND = 0.00851f * fTriangle + 0.00494f * fNoise + 0.00335f * fDMC;
-#else
-    // Better but more expensive and still a bit approx
-    float fPulse = 95.88f / ((8128.f / (fPulse1 + fPulse2)) + 100.f);
-    float fTND = 159.79f / ((1.f / ((fTriangle / 8227.f) + (fNoise / 12241.f) + (fDMC / 22638.f))) + 100.f);
-#endif
-
-    float fExternalAudio = m_bus.AudioOut();
-    
-    // TODO filters
-    // A first-order high-pass filter at 90 Hz
-    // Another first-order high-pass filter at 440 Hz
-    // A first-order low-pass filter at 14 kHz
+    uint32_t pulse1 = m_pulse1.OutputValue();
+    uint32_t pulse2 = m_pulse2.OutputValue();
+    uint32_t triangle = m_triangle.OutputValue();
+    uint32_t noise = m_noise.OutputValue();
+    uint32_t dmc = m_dmc.OutputValue();
+
+    // Pulse 0-15 each, triangle 0-15, noise 0-15, DMC 0-127
+    float fPulse = PULSE_MIX.m_values[pulse1 + pulse2];
+    float fTND = TND_MIX.m_values[3 * triangle + 2 * noise + dmc];
 
+    // Cart audio as last polled
+    float fExternalAudio = m_externalAudio;
+    
+    // Output stage filters are run over finished samples - see FilterAudio
     return fPulse + fTND + fExternalAudio;
 }
 
+void APUNES::ScheduleEvents()
+{
+    // Saved state is always in step
+    m_syncCycle = m_bus.GetCycleCount() + 1;
+    
+    ScheduleFrameStep();
+    ScheduleDMC();
+}
+
+void APUNES::SystemEvent(uint32_t eventID, uint64_t cycleCount)
+{
+    // Each is queued for the cycle after the APU tick it happens on - the CPU has already ticked on that cycle
+    if(eventID == APU_EVENT_FRAME_STEP)
+    {
+        Sync(cycleCount);
+        
+        // Timer ticks can land on the other CPU tick after the frame counter resets
+        ScheduleFrameStep();
+        ScheduleDMC();
+    }
+    else if(eventID == APU_EVENT_DMC)
+    {
+        Sync(cycleCount);
+        ScheduleDMC();
+    }
+}
+
+uint64_t APUNES::LastTickCycle() const
+{
+    // Ticked with the CPU every third master cycle
+    const uint64_t lastCycle = m_syncCycle - 1;
+    return lastCycle - (lastCycle % 3);
+}
+
+uint32_t APUNES::TicksUntilFrameStep() const
+{
+    // APU ticks until the frame counter next reaches a step
+    uint32_t ticks = (0x10000 - m_frameCounter) + FRAME_STEPS[0];
+    for(uint32_t step = 0;step < sizeof(FRAME_STEPS) / sizeof(FRAME_STEPS[0]);++step)
+    {
+        if(FRAME_STEPS[step] > m_frameCounter)
+        {
+            ticks = FRAME_STEPS[step] - m_frameCounter;
+            break;
+        }
+    }
+    return ticks;
+}
+
+void APUNES::ScheduleFrameStep()
+{
+    // Only needs the event to raise its IRQ on time, catching up steps on the tick anyway
+    m_bus.ScheduleEvent(this, APU_EVENT_FRAME_STEP, LastTickCycle() + uint64_t(TicksUntilFrameStep()) * 3 + 1);
+}
+
+void APUNES::ScheduleDMC()
+{
+    if(m_dmc.OutputCycleSignals())
+    {
+        const uint32_t ticks = TimerTicksToCPUTicks(m_dmc.TicksUntilOutputCycle());
+        m_bus.ScheduleEvent(this, APU_EVENT_DMC, LastTickCycle() + uint64_t(ticks) * 3 + 1);
+    }
+    else
+    {
+        m_bus.CancelEvent(this, APU_EVENT_DMC);
+    }
+}
+
+uint64_t APUNES::NextSyncCycle()
+{
+    if(m_pAudioBuffer != nullptr && m_bus.HasAudioOut())
+    {
+        return LastTickCycle() + uint64_t(m_synth.TicksUntilSample()) * 3;
+    }
+    return kNoEventCycle;
+}
+
 void APUNES::QuarterFrameTick()
 {
     // Envelopes & triangle's linear counter
@@ -859,110 +1061,270 @@ void APUNES::HalfFrameTick()
     m_noise.HalfFrameTick();
 }
 
-void APUNES::Tick()
+void APUNES::Sync(uint64_t cycleCount)
 {
-    ++m_frameCounter;
+    if(cycleCount <= m_syncCycle)
+    {
+        return;
+    }
     
-    uint16_t frameCount = m_frameCounter >> 1;
-    uint16_t halfFrame = m_frameCounter & 1;
+    // Ticked with the CPU on the master cycles that are multiples of 3
+    uint64_t ticks = (cycleCount + 2) / 3 - (m_syncCycle + 2) / 3;
+    m_syncCycle = cycleCount;
     
-    // Ticked every second CPU tick
-    if(halfFrame == 0)
+    while(ticks > 0)
     {
-        m_pulse1.Tick();
-        m_pulse2.Tick();
-        m_noise.Tick();
-        m_dmc.Tick();
+        const uint32_t changeTicks = TicksUntilChange();
+        if(changeTicks > ticks)
+        {
+            SkipTicks(uint32_t(ticks));
+            break;
+        }
+        
+        // Straight to the tick something happens on
+        SkipTicks(changeTicks - 1);
+        Tick();
+        ticks -= changeTicks;
     }
+}
 
-    // Ticked every CPU tick
-    m_triangle.Tick();
+uint32_t APUNES::TimerTicksToCPUTicks(uint32_t timerTicks) const
+{
+    if(timerTicks == kAPUTimerStopped)
+    {
+        return kAPUTimerStopped;
+    }
     
-    if(frameCount == 3728 && halfFrame == 1)
+    // Pulse, noise and DMC timers count on the CPU ticks the frame counter lands on an even value
+    const uint32_t firstTick = ((m_frameCounter + 1) & 1) == 0 ? 1 : 2;
+    return firstTick + (timerTicks - 1) * 2;
+}
+
+uint32_t APUNES::TicksUntilChange() const
+{
+    // Register write still to be mixed on the next tick
+    if(m_bOutputChanged && m_pAudioBuffer != nullptr)
     {
-        QuarterFrameTick();
+        return 1;
     }
-    else if(frameCount == 7456 && halfFrame == 1)
+    
+    uint32_t timerTicks = m_pulse1.TicksUntilClock();
+    uint32_t channelTicks = m_pulse2.TicksUntilClock();
+    if(channelTicks < timerTicks)
     {
-        QuarterFrameTick();
-        HalfFrameTick();
+        timerTicks = channelTicks;
     }
-    else if(frameCount == 11185 && halfFrame == 1)
+    channelTicks = m_noise.TicksUntilClock();
+    if(channelTicks < timerTicks)
     {
-        QuarterFrameTick();
+        timerTicks = channelTicks;
     }
-    else if(frameCount == 14914 && halfFrame == 0 && m_frameCountMode == 0 && m_frameInhibitIRQ == 0)
+    channelTicks = m_dmc.TicksUntilClock();
+    if(channelTicks < timerTicks)
     {
-        m_bus.SignalIRQ(true);
+        timerTicks = channelTicks;
     }
-    else if(frameCount == 14914 && halfFrame == 1 && m_frameCountMode == 0)
+    
+    uint32_t ticks = TimerTicksToCPUTicks(timerTicks);
+    channelTicks = m_triangle.TicksUntilClock();
+    if(channelTicks < ticks)
     {
-        QuarterFrameTick();
-        HalfFrameTick();
+        ticks = channelTicks;
     }
-    else if(frameCount == 14915 && m_frameCountMode == 0)
+    
+    const uint32_t frameStepTicks = TicksUntilFrameStep();
+    if(frameStepTicks < ticks)
     {
-        m_frameCounter = 0;
+        ticks = frameStepTicks;
     }
-    else if(frameCount == 18640 && halfFrame == 1)
+    
+    if(m_pAudioBuffer != nullptr)
+    {
+        const uint32_t sampleTicks = m_synth.TicksUntilSample();
+        if(sampleTicks < ticks)
+        {
+            ticks = sampleTicks;
+        }
+    }
+    
+    return ticks;
+}
+
+void APUNES::SkipTicks(uint32_t ticks)
+{
+    // Nothing clocks or outputs on these, all that happens is the counting
+    const uint32_t timerTicks = ((m_frameCounter + 1) & 1) == 0 ? (ticks + 1) / 2 : ticks / 2;
+    m_frameCounter += uint16_t(ticks);
+    
+    m_pulse1.SkipTicks(timerTicks);
+    m_pulse2.SkipTicks(timerTicks);
+    m_noise.SkipTicks(timerTicks);
+    m_dmc.SkipTicks(timerTicks);
+    m_triangle.SkipTicks(ticks);
+    
+    if(m_pAudioBuffer != nullptr)
+    {
+        m_synth.SkipTicks(ticks);
+    }
+}
+
+void APUNES::Tick()
+{
+    ++m_frameCounter;
+    
+    uint16_t frameCount = m_frameCounter >> 1;
+    uint16_t halfFrame = m_frameCounter & 1;
+    
+    // Ticked every second CPU tick
+    bool bOutputChanged = m_bOutputChanged;
+    if(halfFrame == 0)
     {
-        QuarterFrameTick();
-        HalfFrameTick();
+        bOutputChanged |= m_pulse1.Tick();
+        bOutputChanged |= m_pulse2.Tick();
+        bOutputChanged |= m_noise.Tick();
+        bOutputChanged |= m_dmc.Tick();
     }
-    else if(frameCount == 18641)
+
+    // Ticked every CPU tick
+    bOutputChanged |= m_triangle.Tick();
+    
+    // Only the frame steps can match any of these
+    if(IsFrameStep(m_frameCounter))
     {
-        m_frameCounter = 0;
+        bOutputChanged = true;
+        
+        if(frameCount == 3728 && halfFrame == 1)
+        {
+            QuarterFrameTick();
+        }
+        else if(frameCount == 7456 && halfFrame == 1)
+        {
+            QuarterFrameTick();
+            HalfFrameTick();
+        }
+        else if(frameCount == 11185 && halfFrame == 1)
+        {
+            QuarterFrameTick();
+        }
+        else if(frameCount == 14914 && halfFrame == 0 && m_frameCountMode == 0 && m_frameInhibitIRQ == 0)
+        {
+            m_bus.SignalIRQ(true);
+        }
+        else if(frameCount == 14914 && halfFrame == 1 && m_frameCountMode == 0)
+        {
+            QuarterFrameTick();
+            HalfFrameTick();
+        }
+        else if(frameCount == 14915 && m_frameCountMode == 0)
+        {
+            m_frameCounter = 0;
+        }
+        else if(frameCount == 18640 && halfFrame == 1)
+        {
+            QuarterFrameTick();
+            HalfFrameTick();
+        }
+        else if(frameCount == 18641)
+        {
+            m_frameCounter = 0;
+        }
     }
     
     if(m_pAudioBuffer != nullptr)
     {
-        // TODO: This is a bit of a down sample hack - think of a better way!
-        // 89342 frame ticks, this is ticked every 3
-        // 89342 / 3 = 29780.6667
-        // We want 800 samples per 1/60 sec (48000 KHz / 60 fps = 800 samples)
-        // 29780.6667 / 800 = 37.225
-        // So we can sample ever 37.225 ticks
-        ++m_audioOutDataCounter;
-        // If we have hit 37 (or sometimes 38 for the .225 part - every 5 samples) create a sample for the buffer
-        size_t sampleCouner = 37;
-        if(m_pAudioBuffer->GetSamplesWritten() % 5 == 0)
+        // Channel outputs can only change when a timer clocks, on frame steps or register writes
+        // Only mixed again when one of them really did, the synth turns each change into a band-limited step
+        if(bOutputChanged)
         {
-            sampleCouner = sampleCouner + 1;
+            m_bOutputChanged = false;
+            
+            const uint32_t channelOutput =  uint32_t(m_pulse1.OutputValue()) |
+                                            uint32_t(m_pulse2.OutputValue()) << 4 |
+                                            uint32_t(m_triangle.OutputValue()) << 8 |
+                                            uint32_t(m_noise.OutputValue()) << 12 |
+                                            uint32_t(m_dmc.OutputValue()) << 16;
+            if(channelOutput != m_channelOutput)
+            {
+                m_channelOutput = channelOutput;
+                m_synth.SetAmplitude(OutputValue());
+                
+                if(m_pStemBuffer != nullptr)
+                {
+                    UpdateStems();
+                }
+            }
         }
-        if(m_audioOutDataCounter >= sampleCouner)
+        
+        if(m_synth.Tick())
         {
-            m_audioOutDataCounter = 0;
-            m_pAudioBuffer->AddSample(OutputValue());
+            m_pAudioBuffer->AddSample(m_synth.ReadSample());
+            
+            if(m_pStemBuffer != nullptr)
+            {
+                float stems[APU_STEM_COUNT];
+                for(uint32_t stem = 0;stem < APU_STEM_COUNT;++stem)
+                {
+                    stems[stem] = m_stemSynths[stem].ReadSample();
+                }
+                m_pStemBuffer->AddFrame(stems);
+            }
+            
+            // Cart audio can't say when it changes - polled once a sample as it always was
+            const float fExternalAudio = m_bus.AudioOut();
+            if(fExternalAudio != m_externalAudio)
+            {
+                m_externalAudio = fExternalAudio;
+                m_synth.SetAmplitude(OutputValue());
+                
+                if(m_pStemBuffer != nullptr)
+                {
+                    UpdateStems();
+                }
+            }
         }
     }
 }
 
+uint8_t APUNES::Status() const
+{
+    // IF-D NT21 	DMC interrupt (I), frame interrupt (F), DMC active (D), length counter > 0 (N/T/2/1)
+    uint8_t status = 0;
+    
+    status |= m_pulse1.IsEnabled() << 0;
+    status |= m_pulse2.IsEnabled() << 1;
+    status |= m_triangle.IsEnabled() << 2;
+    status |= m_noise.IsEnabled() << 3;
+    status |= m_dmc.IsEnabled() << 4;
+
+    status |= m_frameInhibitIRQ << 6;
+    status |= m_dmc.IsIRQEnabled() << 7;
+    
+    return status;
+}
+
 uint8_t APUNES::cpuRead(uint16_t address)
 {
     if(address == SND_CHN)
     {
-        // IF-D NT21 	DMC interrupt (I), frame interrupt (F), DMC active (D), length counter > 0 (N/T/2/1)
-        uint8_t status = 0;
-        
-        status |= m_pulse1.IsEnabled() << 0;
-        status |= m_pulse2.IsEnabled() << 1;
-        status |= m_triangle.IsEnabled() << 2;
-        status |= m_noise.IsEnabled() << 3;
-        status |= m_dmc.IsEnabled() << 4;
-
-        status |= m_frameInhibitIRQ << 6;
-        status |= m_dmc.IsIRQEnabled() << 7;
+        m_statusRead = Status();
 
         // Clear frame interrupt flag on read
         m_frameInhibitIRQ = 0;
         
-        return status;
+        return m_statusRead;
     }
     return 0;
 }
 
+bool APUNES::StatusMatchesLastRead() const
+{
+    return Status() == m_statusRead;
+}
+
 void APUNES::cpuWrite(uint16_t address, uint8_t byte)
 {
+    m_bOutputChanged = true;
+    
     switch(address)
     {
         case SQ1_VOL:
@@ -992,6 +1354,7 @@ void APUNES::cpuWrite(uint16_t address, uint8_t byte)
         case DMC_START:
         case DMC_LEN:
             m_dmc.SetRegister(address - 0x4010, byte);
+            ScheduleDMC();
             break;
         case SND_CHN:
             // Sset status and enabled flags
@@ -1001,6 +1364,7 @@ void APUNES::cpuWrite(uint16_t address, uint8_t byte)
             m_triangle.SetEnabled((byte >> 2) & 0b1);
             m_noise.SetEnabled((byte >> 3) & 0b1);
             m_dmc.SetEnabled((byte >> 4) & 0b1);
+            ScheduleDMC();
             break;
         case FRAME_COUNTER:
             // MI-- ----    M=0 4 step, M=1 5 Step
@@ -1019,15 +1383,88 @@ void APUNES::SetAudioOutputBuffer(APUAudioBuffer* pAudioBuffer)
 {
     if(m_pAudioBuffer != nullptr)
     {
+        FilterAudio();
         m_pAudioBuffer->Finialise();
     }
 
     m_pAudioBuffer = pAudioBuffer;
+    m_filteredSamples = 0;
     
     if(m_pAudioBuffer != nullptr)
     {
         m_pAudioBuffer->Reset();
+        
+        // Channel changes weren't tracked while detached - mix again on the next tick
+        m_bOutputChanged = true;
     }
+}
+
+void APUNES::BeginAudioFrame()
+{
+    if(m_pAudioBuffer != nullptr)
+    {
+        FilterAudio();
+        m_pAudioBuffer->Reset();
+    }
+    m_filteredSamples = 0;
+}
+
+void APUNES::SetAudioSampleRate(double sampleRate)
+{
+    m_synth.SetRates(kCPUClockRate, sampleRate);
+    m_filter.SetSampleRate(sampleRate);
+}
+
+void APUNES::SetAudioStemBuffer(APUStemBuffer* pStemBuffer)
+{
+    // Starting capture - each stem steps up from silence to the channel's current level
+    if(m_pStemBuffer == nullptr && pStemBuffer != nullptr)
+    {
+        for(uint32_t stem = 0;stem < APU_STEM_COUNT;++stem)
+        {
+            m_stemSynths[stem].Reset();
+        }
+        UpdateStems();
+    }
+    
+    m_pStemBuffer = pStemBuffer;
+    
+    if(m_pStemBuffer != nullptr)
+    {
+        m_pStemBuffer->Reset();
+    }
+}
+
+void APUNES::UpdateStems()
+{
+    // Each channel as the mixer would output it with the others silent
+    const float stems[APU_STEM_COUNT] =
+    {
+        PULSE_MIX.m_values[m_pulse1.OutputValue()],
+        PULSE_MIX.m_values[m_pulse2.OutputValue()],
+        TND_MIX.m_values[3 * m_triangle.OutputValue()],
+        TND_MIX.m_values[2 * m_noise.OutputValue()],
+        TND_MIX.m_values[m_dmc.OutputValue()],
+        m_externalAudio
+    };
     
-    m_audioOutDataCounter = 0;
+    for(uint32_t stem = 0;stem < APU_STEM_COUNT;++stem)
+    {
+        m_stemSynths[stem].FollowPhase(m_synth);
+        m_stemSynths[stem].SetAmplitude(stems[stem]);
+    }
+}
+
+void APUNES::FilterAudio()
+{
+    if(m_pAudioBuffer != nullptr)
+    {
+        const size_t samplesWritten = m_pAudioBuffer->GetSamplesWritten();
+        if(samplesWritten > m_filteredSamples)
+        {
+            // In the order they were made - backwards through a reversed buffer
+            m_filter.Process(m_pAudioBuffer->GetSamplesFrom(m_filteredSamples), uint32_t(samplesWritten - m_filteredSamples), m_pAudioBuffer->ShouldReverseBuffer());
+            m_filteredSamples = samplesWritten;
+        }
+    }
 }
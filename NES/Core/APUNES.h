@@ -10,8 +10,14 @@
 
 #include "IOBus.h"
 #include "Serialise.h"
+#include "EventQueue.h"
+#include "AudioSynth.h"
+#include "AudioFilter.h"
 #include <atomic>
 
+// Channel timer that isn't counting - it won't clock until a register write or frame step starts it
+const uint32_t kAPUTimerStopped = ~uint32_t(0);
+
 class APUAudioBuffer
 {
 public:
@@ -100,10 +106,24 @@ public:
     {
         m_bReverseFlag = bReverse;
     }
+    bool ShouldReverseBuffer() const
+    {
+        return m_bReverseFlag;
+    }
     float const* GetSampleBuffer() const
     {
         return m_pBuffer;
     }
+    // Just the samples written so far in play order - reversed buffers fill from the end
+    float const* GetWrittenSamples() const
+    {
+        return m_bReverseFlag ? m_pBuffer + m_bufferSize - m_samplesWritten : m_pBuffer;
+    }
+    // Samples written from the first'th on, lowest address first - reversed buffers hold the last written first
+    float* GetSamplesFrom(size_t first)
+    {
+        return m_bReverseFlag ? m_pBuffer + m_bufferSize - m_samplesWritten : m_pBuffer + first;
+    }
 
 private:
     float* m_pBuffer;
@@ -113,6 +133,77 @@ private:
     std::atomic<bool> m_bReady;
 };
 
+// Each channel on its own, one interleaved frame per output sample
+enum APUStem : uint32_t
+{
+    APU_STEM_PULSE1 = 0,
+    APU_STEM_PULSE2,
+    APU_STEM_TRIANGLE,
+    APU_STEM_NOISE,
+    APU_STEM_DMC,
+    APU_STEM_EXTERNAL,                  // Cart audio - VRC6, FME-7
+    APU_STEM_COUNT
+};
+
+class APUStemBuffer
+{
+public:
+    APUStemBuffer()
+    : m_pBuffer(nullptr)
+    , m_frameCapacity(0)
+    , m_framesWritten(0)
+    {}
+    APUStemBuffer(size_t frameCapacity)
+    : m_pBuffer(nullptr)
+    , m_frameCapacity(frameCapacity)
+    , m_framesWritten(0)
+    {
+        m_pBuffer = new float[m_frameCapacity * APU_STEM_COUNT];
+    }
+    ~APUStemBuffer()
+    {
+        if(m_pBuffer != nullptr)
+        {
+            delete [] m_pBuffer;
+            m_pBuffer = nullptr;
+        }
+    }
+    size_t GetFrameCapacity() const
+    {
+        return m_frameCapacity;
+    }
+    size_t GetFramesWritten() const
+    {
+        return m_framesWritten;
+    }
+    void Reset()
+    {
+        m_framesWritten = 0;
+    }
+    void AddFrame(const float* pStems)
+    {
+        if(m_framesWritten < m_frameCapacity && m_pBuffer != nullptr)
+        {
+            float* pFrame = m_pBuffer + m_framesWritten * APU_STEM_COUNT;
+            for(uint32_t stem = 0;stem < APU_STEM_COUNT;++stem)
+            {
+                pFrame[stem] = pStems[stem];
+            }
+            ++m_framesWritten;
+        }
+    }
+    // APU_STEM_COUNT floats a frame in APUStem order
+    float const* GetSampleBuffer() const
+    {
+        return m_pBuffer;
+    }
+
+private:
+    float* m_pBuffer;
+    size_t m_frameCapacity;
+    size_t m_framesWritten;
+};
+
 class APUPulseChannel : public Serialisable
 {
 public:
@@ -126,7 +217,9 @@ public:
     uint8_t OutputValue() const;
     void SetRegister(uint16_t reg, uint8_t byte);
     
-    void Tick();
+    bool Tick();                        // True when the timer clocked the sequencer - output may have changed
+    uint32_t TicksUntilClock() const;   // Ticks until Tick next returns true - kAPUTimerStopped while it can't
+    void SkipTicks(uint32_t ticks);     // Fewer ticks than TicksUntilClock all at once
     void QuarterFrameTick();
     void HalfFrameTick();
     
@@ -179,7 +272,9 @@ public:
     uint8_t OutputValue() const;
     void SetRegister(uint16_t reg, uint8_t byte);
     
-    void Tick();
+    bool Tick();                        // True when the timer clocked the sequencer - output may have changed
+    uint32_t TicksUntilClock() const;   // Ticks until Tick next returns true - kAPUTimerStopped while it can't
+    void SkipTicks(uint32_t ticks);     // Fewer ticks than TicksUntilClock all at once
     void QuarterFrameTick();
     void HalfFrameTick();
     
@@ -213,7 +308,9 @@ public:
     uint8_t OutputValue() const;
     void SetRegister(uint16_t reg, uint8_t byte);
     
-    void Tick();
+    bool Tick();                        // True when the timer clocked the sequencer - output may have changed
+    uint32_t TicksUntilClock() const;   // Ticks until Tick next returns true - kAPUTimerStopped while it can't
+    void SkipTicks(uint32_t ticks);     // Fewer ticks than TicksUntilClock all at once
     void QuarterFrameTick();
     void HalfFrameTick();
 
@@ -255,7 +352,16 @@ public:
     uint8_t OutputValue() const;
     void SetRegister(uint16_t reg, uint8_t byte);
     
-    void Tick();
+    bool Tick();                        // True when the timer clocked the output unit - output may have changed
+    uint32_t TicksUntilClock() const;
+    void SkipTicks(uint32_t ticks);
+    
+    // Ticks until the output unit starts its next 8 bit cycle - where it fetches a sample byte or raises its IRQ
+    uint32_t TicksUntilOutputCycle() const;
+    
+    // The next output cycle could read the bus or raise an IRQ
+    bool OutputCycleSignals() const;
+
 private:
 
     SystemIOBus& m_bus;
@@ -285,24 +391,69 @@ private:
     uint16_t m_sampleLengthRemaining;
 };
 
-class APUNES : public Serialisable
+class APUNES : public Serialisable, public SystemEventHandler
 {
 public:
     SERIALISABLE_DECL
     
+    enum APU_EVENT : uint32_t
+    {
+        APU_EVENT_FRAME_STEP = 0,
+        APU_EVENT_DMC                   // DMC output cycle that fetches or raises its IRQ
+    };
+    
     APUNES(SystemIOBus& bus);
     ~APUNES();
     
+    // Mix of the channels and cart audio as last polled
     float OutputValue();
-    void Tick();
+    
+    // Run every APU tick before master cycle cycleCount - caught up on CPU access and events rather than ticked
+    // Goes from one channel timer clock or output sample to the next, nothing happens on the ticks between
+    void Sync(uint64_t cycleCount);
+    
+    // Master cycle it has to be caught up to by, kNoEventCycle when access and events are enough
+    // Cart audio is polled as each output sample is finished - not worth an event as the CPU can't see it
+    uint64_t NextSyncCycle();
+    
+    // Queue the next frame sequencer step and DMC output cycle after power on or load
+    void ScheduleEvents();
+    virtual void SystemEvent(uint32_t eventID, uint64_t cycleCount) override;
     
     uint8_t cpuRead(uint16_t address);
     void cpuWrite(uint16_t address, uint8_t byte);
     
+    // SND_CHN would read back the same as last time - it only changes on frame sequencer steps or writes
+    bool StatusMatchesLastRead() const;
+    
     void QuarterFrameTick();
     void HalfFrameTick();
     
     void SetAudioOutputBuffer(APUAudioBuffer* pAudioBuffer);
+    void SetAudioSampleRate(double sampleRate);
+    
+    // Start the next frame in the same output buffer - the last frame's samples are filtered and already taken, no padding
+    void BeginAudioFrame();
+    
+    // Run the output filters over the samples written since the last call - a block at a time rather than per sample
+    void FilterAudio();
+    
+    // Capture each channel alongside the mix, nullptr to stop - only while an audio output buffer is set
+    // Levels are each channel alone through the mixer, before the output filters
+    void SetAudioStemBuffer(APUStemBuffer* pStemBuffer);
+
+private:
+    void Tick();
+    void SkipTicks(uint32_t ticks);
+    uint32_t TicksUntilChange() const;
+    uint32_t TicksUntilFrameStep() const;
+    uint32_t TimerTicksToCPUTicks(uint32_t timerTicks) const;
+    
+    uint64_t LastTickCycle() const;
+    void ScheduleFrameStep();
+    void ScheduleDMC();
+    uint8_t Status() const;
+    void UpdateStems();
 
 private:
     SystemIOBus& m_bus;
@@ -311,6 +462,8 @@ private:
     uint16_t m_frameCounter;
     uint8_t m_frameCountMode;
     uint8_t m_frameInhibitIRQ;
+    uint64_t m_syncCycle;               // Every tick before this master cycle has run
+    uint8_t m_statusRead;               // Last SND_CHN value read
     
     // Channels
     APUPulseChannel     m_pulse1;
@@ -319,9 +472,18 @@ private:
     APUNoiseChannel     m_noise;
     APUDMC              m_dmc;
     
-    // Output
+    // Output - mixed again only when a channel output changes, pulse1 | pulse2 << 4 | triangle << 8 | noise << 12 | DMC << 16
     APUAudioBuffer* m_pAudioBuffer;
-    size_t m_audioOutDataCounter;
+    AudioSynth m_synth;
+    AudioFilterChain m_filter;
+    size_t m_filteredSamples;           // Samples of the output buffer already filtered
+    bool m_bOutputChanged;              // Register write or load since the last mix
+    uint32_t m_channelOutput;
+    float m_externalAudio;
+    
+    // Stem capture - the synths place their changes by m_synth's clock, untouched while capture is off
+    APUStemBuffer* m_pStemBuffer;
+    AudioSynth m_stemSynths[APU_STEM_COUNT];
 };
 
 #endif /* APUNES_h */
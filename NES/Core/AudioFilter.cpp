@@ -0,0 +1,141 @@
+//
+//  AudioFilter.cpp
+//  NES
+//
+
+#include "AudioFilter.h"
+#include <cmath>
+
+#if AUDIO_FILTER_FIXED_POINT
+const int32_t kFilterOne = 1 << 16;
+
+static inline int32_t ToFilterValue(double value)
+{
+    return int32_t(lrint(value * double(kFilterOne)));
+}
+
+static inline int32_t FilterSample(float sample)
+{
+    return int32_t(lrintf(sample * float(kFilterOne)));
+}
+
+static inline float FilterOutput(int32_t value)
+{
+    return float(value) * (1.f / float(kFilterOne));
+}
+
+static inline int32_t FilterMul(int32_t coeff, int32_t value)
+{
+    return int32_t((int64_t(coeff) * int64_t(value) + (kFilterOne >> 1)) >> 16);
+}
+#else
+static inline float ToFilterValue(double value)
+{
+    return float(value);
+}
+
+static inline float FilterSample(float sample)
+{
+    return sample;
+}
+
+static inline float FilterOutput(float value)
+{
+    return value;
+}
+
+static inline float FilterMul(float coeff, float value)
+{
+    return coeff * value;
+}
+#endif
+
+// First-order RC sections sampled at dt
+static double HighPassCoeff(double cutoff, double sampleRate)
+{
+    const double rc = 1.0 / (2.0 * 3.14159265358979323846 * cutoff);
+    const double dt = 1.0 / sampleRate;
+    return rc / (rc + dt);
+}
+
+static double LowPassCoeff(double cutoff, double sampleRate)
+{
+    const double rc = 1.0 / (2.0 * 3.14159265358979323846 * cutoff);
+    const double dt = 1.0 / sampleRate;
+    return dt / (rc + dt);
+}
+
+AudioFilterChain::AudioFilterChain()
+{
+    SetSampleRate(48000.0);
+    Reset();
+}
+
+void AudioFilterChain::SetSampleRate(double sampleRate)
+{
+    m_highPassCoeff[0] = ToFilterValue(HighPassCoeff(kAudioFilterHighPass0, sampleRate));
+    m_highPassCoeff[1] = ToFilterValue(HighPassCoeff(kAudioFilterHighPass1, sampleRate));
+    m_lowPassCoeff = ToFilterValue(LowPassCoeff(kAudioFilterLowPass, sampleRate));
+}
+
+void AudioFilterChain::Reset()
+{
+    m_highPassLastIn[0] = m_highPassLastIn[1] = 0;
+    m_highPassOut[0] = m_highPassOut[1] = 0;
+    m_lowPassOut = 0;
+}
+
+void AudioFilterChain::Process(float* pSamples, uint32_t count, bool bReverse)
+{
+    if(count == 0)
+    {
+        return;
+    }
+
+    if(bReverse)
+    {
+        ProcessBlock<-1>(pSamples + count - 1, count);
+    }
+    else
+    {
+        ProcessBlock<1>(pSamples, count);
+    }
+}
+
+template<int32_t Step>
+void AudioFilterChain::ProcessBlock(float* pSamples, uint32_t count)
+{
+    // Locals so the whole chain stays in registers for the block
+    const Value highPassCoeff0 = m_highPassCoeff[0];
+    const Value highPassCoeff1 = m_highPassCoeff[1];
+    const Value lowPassCoeff = m_lowPassCoeff;
+
+    Value lastIn0 = m_highPassLastIn[0];
+    Value lastIn1 = m_highPassLastIn[1];
+    Value out0 = m_highPassOut[0];
+    Value out1 = m_highPassOut[1];
+    Value lowPassOut = m_lowPassOut;
+
+    for(uint32_t i = 0;i < count;++i)
+    {
+        float& sample = pSamples[int32_t(i) * Step];
+
+        const Value in = FilterSample(sample);
+
+        out0 = FilterMul(highPassCoeff0, out0 + in - lastIn0);
+        lastIn0 = in;
+
+        out1 = FilterMul(highPassCoeff1, out1 + out0 - lastIn1);
+        lastIn1 = out0;
+
+        lowPassOut += FilterMul(lowPassCoeff, out1 - lowPassOut);
+
+        sample = FilterOutput(lowPassOut);
+    }
+
+    m_highPassLastIn[0] = lastIn0;
+    m_highPassLastIn[1] = lastIn1;
+    m_highPassOut[0] = out0;
+    m_highPassOut[1] = out1;
+    m_lowPassOut = lowPassOut;
+}
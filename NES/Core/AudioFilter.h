@@ -0,0 +1,56 @@
+//
+//  AudioFilter.h
+//  NES
+//
+
+#ifndef AudioFilter_h
+#define AudioFilter_h
+
+#include "CoreDefines.h"
+
+// Filter state and maths - 1 = 16.16 fixed point, 0 = float
+#ifndef AUDIO_FILTER_FIXED_POINT
+    #define AUDIO_FILTER_FIXED_POINT 0
+#endif
+
+// The NES analogue output stage - first-order high-pass at 90Hz and 440Hz then a first-order low-pass at 14kHz
+// Run over a block of finished samples at a time, all three stages in one pass with the state held in registers
+const double kAudioFilterHighPass0  = 90.0;
+const double kAudioFilterHighPass1  = 440.0;
+const double kAudioFilterLowPass    = 14000.0;
+
+class AudioFilterChain
+{
+public:
+    AudioFilterChain();
+
+    // Coefficients for the output rate - the state carries on, a small change between blocks doesn't click
+    void SetSampleRate(double sampleRate);
+
+    // Back to silence
+    void Reset();
+
+    // Filters samples in place in the order they were made - bReverse when that is from the end of the block back
+    void Process(float* pSamples, uint32_t count, bool bReverse);
+
+private:
+    template<int32_t Step>
+    void ProcessBlock(float* pSamples, uint32_t count);
+
+private:
+#if AUDIO_FILTER_FIXED_POINT
+    typedef int32_t Value;
+#else
+    typedef float Value;
+#endif
+
+    // y = a * (y + x - lastX) for each high-pass, y += b * (x - y) for the low-pass
+    Value m_highPassCoeff[2];
+    Value m_lowPassCoeff;
+
+    Value m_highPassLastIn[2];
+    Value m_highPassOut[2];
+    Value m_lowPassOut;
+};
+
+#endif /* AudioFilter_h */
@@ -0,0 +1,64 @@
+//
+//  AudioRateControl.cpp
+//  NES
+//
+
+#include "AudioRateControl.h"
+
+AudioRateControl::AudioRateControl()
+: m_sampleRate(0.0)
+, m_targetFillLevel(0.0)
+, m_fillLevel(-1.0)
+, m_integral(0.0)
+, m_adjustedSampleRate(0.0)
+{}
+
+AudioRateControl::AudioRateControl(double sampleRate, uint32_t targetFillLevel)
+: m_sampleRate(sampleRate)
+, m_targetFillLevel(double(targetFillLevel))
+, m_fillLevel(-1.0)
+, m_integral(0.0)
+, m_adjustedSampleRate(sampleRate)
+{}
+
+void AudioRateControl::Reset()
+{
+    m_fillLevel = -1.0;
+    m_integral = 0.0;
+    m_adjustedSampleRate = m_sampleRate;
+}
+
+double AudioRateControl::Update(uint32_t fillLevel)
+{
+    if(m_targetFillLevel <= 0.0)
+    {
+        return m_sampleRate;
+    }
+
+    if(m_fillLevel < 0.0)
+    {
+        m_fillLevel = double(fillLevel);
+    }
+    else
+    {
+        m_fillLevel += (double(fillLevel) - m_fillLevel) * kAudioRateFillSmoothing;
+    }
+
+    // Below target make more samples per frame, above make fewer
+    const double error = (m_targetFillLevel - m_fillLevel) / m_targetFillLevel;
+
+    // Integral can't wind up past what the output could use
+    m_integral += error * kAudioRateIntegralGain;
+    m_integral = m_integral < -kAudioRateMaxAdjust ? -kAudioRateMaxAdjust : (m_integral > kAudioRateMaxAdjust ? kAudioRateMaxAdjust : m_integral);
+
+    double adjust = error * kAudioRateProportionalGain + m_integral;
+    adjust = adjust < -kAudioRateMaxAdjust ? -kAudioRateMaxAdjust : (adjust > kAudioRateMaxAdjust ? kAudioRateMaxAdjust : adjust);
+
+    m_adjustedSampleRate = m_sampleRate * (1.0 + adjust);
+    return m_adjustedSampleRate;
+}
+
+double AudioRateControl::GetSampleRate() const
+{
+    return m_adjustedSampleRate;
+}
@@ -0,0 +1,44 @@
+//
+//  AudioRateControl.h
+//  NES
+//
+
+#ifndef AudioRateControl_h
+#define AudioRateControl_h
+
+#include "CoreDefines.h"
+
+// Dynamic rate control - frames are paced by the display and samples are taken by the audio clock, so an output buffer
+// slowly drains or overflows unless the samples made per frame track the difference
+// Each frame the sample rate to render at is nudged by up to kAudioRateMaxAdjust - too small a change to hear as pitch,
+// large enough to cover the NES 60.0988Hz vs a 59.94Hz display plus audio clock error
+// The proportional part reacts to how far the buffer fill level is from its target, the integral part learns the steady
+// clock difference so the fill level settles on the target rather than short of it
+const double kAudioRateMaxAdjust        = 0.005;
+const double kAudioRateProportionalGain = kAudioRateMaxAdjust * 2.0;                 // Adjust per target fill level of error
+const double kAudioRateIntegralGain     = kAudioRateProportionalGain / 1200.0;       // Per frame - critically damped for 800 sample frames
+const double kAudioRateFillSmoothing    = 1.0 / 16.0;                                // Fill level is read once a frame but drained a host buffer at a time
+
+class AudioRateControl
+{
+public:
+    AudioRateControl();
+    AudioRateControl(double sampleRate, uint32_t targetFillLevel);
+
+    // Forget the fill level history - after the buffer is emptied
+    void Reset();
+
+    // Sample rate to render the next frame at, from the buffer fill level after writing the last one
+    double Update(uint32_t fillLevel);
+
+    double GetSampleRate() const;
+
+private:
+    double      m_sampleRate;
+    double      m_targetFillLevel;
+    double      m_fillLevel;                // Smoothed, negative until the first update
+    double      m_integral;
+    double      m_adjustedSampleRate;
+};
+
+#endif /* AudioRateControl_h */
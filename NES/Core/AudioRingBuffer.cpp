@@ -0,0 +1,152 @@
+//
+//  AudioRingBuffer.cpp
+//  NES
+//
+
+#include "AudioRingBuffer.h"
+#include <string.h>
+
+AudioRingBuffer::AudioRingBuffer()
+: m_pSamples(nullptr)
+, m_capacity(0)
+, m_mask(0)
+, m_writeIndex(0)
+, m_readIndexCache(0)
+, m_droppedSamples(0)
+, m_readIndex(0)
+, m_writeIndexCache(0)
+, m_underrunSamples(0)
+{}
+
+AudioRingBuffer::AudioRingBuffer(uint32_t capacity)
+: AudioRingBuffer()
+{
+    m_capacity = 1;
+    while(m_capacity < capacity)
+    {
+        m_capacity <<= 1;
+    }
+    m_mask = m_capacity - 1;
+    m_pSamples = new float[m_capacity];
+    memset(m_pSamples, 0, sizeof(float) * m_capacity);
+}
+
+AudioRingBuffer::~AudioRingBuffer()
+{
+    if(m_pSamples != nullptr)
+    {
+        delete [] m_pSamples;
+        m_pSamples = nullptr;
+    }
+}
+
+uint32_t AudioRingBuffer::Write(const float* pSamples, uint32_t count)
+{
+    const uint32_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+
+    // Only look at the consumer again when the last look doesn't leave enough room
+    uint32_t space = m_capacity - (writeIndex - m_readIndexCache);
+    if(space < count)
+    {
+        m_readIndexCache = m_readIndex.load(std::memory_order_acquire);
+        space = m_capacity - (writeIndex - m_readIndexCache);
+    }
+
+    const uint32_t writeCount = count < space ? count : space;
+    if(writeCount > 0)
+    {
+        // Up to the end of the storage then the rest from the start
+        const uint32_t start = writeIndex & m_mask;
+        const uint32_t firstCount = writeCount < m_capacity - start ? writeCount : m_capacity - start;
+        memcpy(m_pSamples + start, pSamples, sizeof(float) * firstCount);
+        memcpy(m_pSamples, pSamples + firstCount, sizeof(float) * (writeCount - firstCount));
+
+        // Samples are in place before the consumer can see the new index
+        m_writeIndex.store(writeIndex + writeCount, std::memory_order_release);
+    }
+
+    if(writeCount < count)
+    {
+        m_droppedSamples.fetch_add(count - writeCount, std::memory_order_relaxed);
+    }
+
+    return writeCount;
+}
+
+uint32_t AudioRingBuffer::Read(float* pSamples, uint32_t count)
+{
+    const uint32_t readIndex = m_readIndex.load(std::memory_order_relaxed);
+
+    // Only look at the producer again when the last look doesn't have enough
+    uint32_t available = m_writeIndexCache - readIndex;
+    if(available < count)
+    {
+        m_writeIndexCache = m_writeIndex.load(std::memory_order_acquire);
+        available = m_writeIndexCache - readIndex;
+    }
+
+    const uint32_t readCount = count < available ? count : available;
+    if(readCount > 0)
+    {
+        const uint32_t start = readIndex & m_mask;
+        const uint32_t firstCount = readCount < m_capacity - start ? readCount : m_capacity - start;
+        memcpy(pSamples, m_pSamples + start, sizeof(float) * firstCount);
+        memcpy(pSamples + firstCount, m_pSamples, sizeof(float) * (readCount - firstCount));
+
+        // Samples are copied out before the producer can reuse the space
+        m_readIndex.store(readIndex + readCount, std::memory_order_release);
+    }
+
+    if(readCount < count)
+    {
+        m_underrunSamples.fetch_add(count - readCount, std::memory_order_relaxed);
+    }
+
+    return readCount;
+}
+
+uint32_t AudioRingBuffer::Flush()
+{
+    const uint32_t readIndex = m_readIndex.load(std::memory_order_relaxed);
+
+    // Skip up to the producer - it only ever sees the space grow
+    m_writeIndexCache = m_writeIndex.load(std::memory_order_acquire);
+    m_readIndex.store(m_writeIndexCache, std::memory_order_release);
+
+    return m_writeIndexCache - readIndex;
+}
+
+uint32_t AudioRingBuffer::GetCapacity() const
+{
+    return m_capacity;
+}
+
+uint32_t AudioRingBuffer::GetFillLevel() const
+{
+    const uint32_t readIndex = m_readIndex.load(std::memory_order_acquire);
+    const uint32_t writeIndex = m_writeIndex.load(std::memory_order_acquire);
+
+    // The consumer can move on and the producer refill between the two loads
+    const uint32_t fillLevel = writeIndex - readIndex;
+    return fillLevel < m_capacity ? fillLevel : m_capacity;
+}
+
+uint64_t AudioRingBuffer::GetDroppedSamples() const
+{
+    return m_droppedSamples.load(std::memory_order_relaxed);
+}
+
+uint64_t AudioRingBuffer::GetUnderrunSamples() const
+{
+    return m_underrunSamples.load(std::memory_order_relaxed);
+}
+
+void AudioRingBuffer::Reset()
+{
+    m_writeIndex.store(0, std::memory_order_relaxed);
+    m_readIndexCache = 0;
+    m_droppedSamples.store(0, std::memory_order_relaxed);
+    m_readIndex.store(0, std::memory_order_relaxed);
+    m_writeIndexCache = 0;
+    m_underrunSamples.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,59 @@
+//
+//  AudioRingBuffer.h
+//  NES
+//
+
+#ifndef AudioRingBuffer_h
+#define AudioRingBuffer_h
+
+#include "CoreDefines.h"
+#include <atomic>
+
+const uint32_t kAudioRingCacheLineSize = 64;
+
+// Lock-free float samples from one producer thread (emulation) to one consumer thread (audio output)
+// Each side writes only its own index, so the two never wait on each other - a full ring drops, an empty ring comes up short
+class AudioRingBuffer
+{
+public:
+    AudioRingBuffer();
+    AudioRingBuffer(uint32_t capacity);             // Rounded up to a power of 2
+    ~AudioRingBuffer();
+
+    // Producer - returns the samples written, the rest are dropped when the ring is full
+    uint32_t Write(const float* pSamples, uint32_t count);
+
+    // Consumer - returns the samples read, fewer than asked for when the ring runs dry
+    uint32_t Read(float* pSamples, uint32_t count);
+    
+    // Consumer - drops everything written so far, returns how many samples that was
+    uint32_t Flush();
+
+    // Telemetry from either thread - may already be out of date
+    uint32_t GetCapacity() const;
+    uint32_t GetFillLevel() const;
+    uint64_t GetDroppedSamples() const;             // Written while full
+    uint64_t GetUnderrunSamples() const;            // Asked for while empty
+
+    // Empty and clear the telemetry - only while neither side is running
+    void Reset();
+
+private:
+
+    float*      m_pSamples;
+    uint32_t    m_capacity;
+    uint32_t    m_mask;
+
+    // Free running indices, each on its own cache line with that side's last look at the other one
+    uint8_t                 m_padStart[kAudioRingCacheLineSize];
+    std::atomic<uint32_t>   m_writeIndex;
+    uint32_t                m_readIndexCache;
+    std::atomic<uint64_t>   m_droppedSamples;
+    uint8_t                 m_padWrite[kAudioRingCacheLineSize];
+    std::atomic<uint32_t>   m_readIndex;
+    uint32_t                m_writeIndexCache;
+    std::atomic<uint64_t>   m_underrunSamples;
+    uint8_t                 m_padRead[kAudioRingCacheLineSize];
+};
+
+#endif /* AudioRingBuffer_h */
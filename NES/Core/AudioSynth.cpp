@@ -0,0 +1,102 @@
+//
+//  AudioSynth.cpp
+//  NES
+//
+
+#include "AudioSynth.h"
+#include <string.h>
+
+// Kernel pass band as a fraction of the output Nyquist frequency - the Blackman window rolls off the rest
+const double kAudioSynthCutoff  = 0.8;
+const int32_t kKernelUnit       = 1 << 15;
+
+// Windowed sinc impulse for each phase, fixed point so every phase sums to exactly kKernelUnit and a step settles exactly
+struct AudioSynthKernel
+{
+    AudioSynthKernel()
+    {
+        const double pi = 3.14159265358979323846;
+        const double halfWidth = double(kAudioSynthKernelWidth) / 2.0;
+
+        for(uint32_t phase = 0;phase < kAudioSynthPhaseCount;++phase)
+        {
+            // Step lands this far past the sample before the first tap, plus half the width of latency
+            const double offset = double(phase) / double(kAudioSynthPhaseCount);
+
+            double impulse[kAudioSynthKernelWidth];
+            double sum = 0.0;
+            for(uint32_t tap = 0;tap < kAudioSynthKernelWidth;++tap)
+            {
+                const double distance = double(tap + 1) - offset - halfWidth;
+                const double x = pi * kAudioSynthCutoff * distance;
+                const double sinc = x != 0.0 ? sin(x) / x : 1.0;
+                const double window = 0.42 + 0.5 * cos(pi * distance / halfWidth) + 0.08 * cos(2.0 * pi * distance / halfWidth);
+
+                impulse[tap] = sinc * window;
+                sum += impulse[tap];
+            }
+
+            // Rounding left over goes on the largest tap
+            int32_t total = 0;
+            uint32_t largestTap = 0;
+            for(uint32_t tap = 0;tap < kAudioSynthKernelWidth;++tap)
+            {
+                m_taps[phase][tap] = int32_t(lrint(impulse[tap] / sum * double(kKernelUnit)));
+                total += m_taps[phase][tap];
+                if(m_taps[phase][tap] > m_taps[phase][largestTap])
+                {
+                    largestTap = tap;
+                }
+            }
+            m_taps[phase][largestTap] += kKernelUnit - total;
+        }
+    }
+
+    int32_t m_taps[kAudioSynthPhaseCount][kAudioSynthKernelWidth];
+};
+
+static const AudioSynthKernel kAudioSynthKernel;
+
+AudioSynth::AudioSynth()
+: m_phase(0)
+, m_phaseStep(0)
+, m_readPos(0)
+, m_sum(0)
+, m_amplitude(0)
+{
+    memset(m_buffer, 0, sizeof(m_buffer));
+}
+
+void AudioSynth::SetRates(double clockRate, double sampleRate)
+{
+    m_phaseStep = uint64_t(sampleRate / clockRate * double(kPhaseOne));
+}
+
+void AudioSynth::Reset()
+{
+    m_phase = 0;
+    m_readPos = 0;
+    m_sum = 0;
+    m_amplitude = 0;
+    memset(m_buffer, 0, sizeof(m_buffer));
+}
+
+void AudioSynth::AddDelta(int32_t delta)
+{
+    // The next output sample is the first one this tick's change can reach
+    const int32_t* pTaps = kAudioSynthKernel.m_taps[m_phase >> (32 - kAudioSynthPhaseBits)];
+    for(uint32_t tap = 0;tap < kAudioSynthKernelWidth;++tap)
+    {
+        m_buffer[(m_readPos + tap) & (kAudioSynthBufferSize - 1)] += int64_t(delta) * pTaps[tap];
+    }
+}
+
+float AudioSynth::ReadSample()
+{
+    // Running sum of the impulses turns them back into steps
+    m_sum += m_buffer[m_readPos];
+    m_buffer[m_readPos] = 0;
+    m_readPos = (m_readPos + 1) & (kAudioSynthBufferSize - 1);
+
+    return float(double(m_sum) * (1.0 / (double(kAmplitudeScale) * double(kKernelUnit))));
+}
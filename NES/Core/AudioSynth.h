@@ -0,0 +1,93 @@
+//
+//  AudioSynth.h
+//  NES
+//
+
+#ifndef AudioSynth_h
+#define AudioSynth_h
+
+#include "CoreDefines.h"
+#include <cmath>
+
+// Band-limited step synthesis - the amplitude can change on any input clock tick, output is at any lower sample rate
+// Each change adds a windowed sinc impulse at its exact position between output samples and the output is the running sum,
+// so a step comes out band-limited and the work is per change rather than per tick
+const uint32_t kAudioSynthKernelWidth   = 16;               // Output samples each change is spread over - half of it is output latency
+const uint32_t kAudioSynthPhaseBits     = 6;                // Positions between output samples the kernel is built for
+const uint32_t kAudioSynthPhaseCount    = 1 << kAudioSynthPhaseBits;
+const uint32_t kAudioSynthBufferSize    = 32;               // Power of 2 at least the kernel width
+
+class AudioSynth
+{
+public:
+    AudioSynth();
+
+    // Input clock ticks and output samples per second
+    void SetRates(double clockRate, double sampleRate);
+
+    // Back to silence with nothing pending
+    void Reset();
+
+    // Amplitude from this tick on - nothing to do unless it changed
+    void SetAmplitude(float amplitude)
+    {
+        const int32_t amplitudeFixed = int32_t(lrintf(amplitude * float(kAmplitudeScale)));
+        if(amplitudeFixed != m_amplitude)
+        {
+            AddDelta(amplitudeFixed - m_amplitude);
+            m_amplitude = amplitudeFixed;
+        }
+    }
+
+    // Moves on one input clock tick - true when an output sample is finished, call ReadSample before the next tick
+    bool Tick()
+    {
+        m_phase += m_phaseStep;
+        if(m_phase >= kPhaseOne)
+        {
+            m_phase -= kPhaseOne;
+            return true;
+        }
+        return false;
+    }
+
+    // Ticks until Tick next returns true, at least 1
+    uint32_t TicksUntilSample() const
+    {
+        return uint32_t((kPhaseOne - m_phase + m_phaseStep - 1) / m_phaseStep);
+    }
+
+    // Ticks that don't finish a sample - fewer than TicksUntilSample
+    void SkipTicks(uint32_t ticks)
+    {
+        m_phase += m_phaseStep * ticks;
+    }
+
+    float ReadSample();
+    
+    // Place changes by another synth's clock rather than ticking this one - for several outputs sampled together
+    void FollowPhase(const AudioSynth& clock)
+    {
+        m_phase = clock.m_phase;
+    }
+
+private:
+    static const int32_t kAmplitudeScale    = 1 << 16;      // 1.0 amplitude
+    static const uint64_t kPhaseOne         = uint64_t(1) << 32;
+
+    void AddDelta(int32_t delta);
+
+private:
+    // Input tick position between the last output sample and the next, 32 bit fraction
+    uint64_t m_phase;
+    uint64_t m_phaseStep;
+
+    // Impulses still to be summed into output - m_readPos is the next output sample
+    int64_t m_buffer[kAudioSynthBufferSize];
+    uint32_t m_readPos;
+
+    int64_t m_sum;
+    int32_t m_amplitude;
+};
+
+#endif /* AudioSynth_h */
@@ -0,0 +1,199 @@
+//
+//  CPU6502-ITable.h
+//  NES
+//
+//  Opcode table - no include guard, define these then include to expand it:
+//  CPU6502_INSTRUCTION(opCode, handler)                - handler runs the whole instruction
+//  CPU6502_OPERATION(opCode, addressMode, operation)   - address mode handler specialised on the operation
+//  CPU6502_NOP(opCode, handler)                        - extra address mode NOPs, these share handlers
+//
+
+CPU6502_INSTRUCTION(0x00, BRK)
+CPU6502_OPERATION(0x01, InternalExecutionMemory_indX, ORA)
+CPU6502_OPERATION(0x05, InternalExecutionMemory_zpg, ORA)
+CPU6502_OPERATION(0x06, ReadModifyWrite_zpg, RMW_ASL)
+CPU6502_OPERATION(0x08, StackPush, PHP)
+CPU6502_OPERATION(0x09, InternalExecutionMemory_imm, ORA)
+CPU6502_OPERATION(0x10, Branch, BPL)
+CPU6502_OPERATION(0x11, InternalExecutionMemory_indY, ORA)
+CPU6502_INSTRUCTION(0x0A, Accum_ASL)
+CPU6502_OPERATION(0x0D, InternalExecutionMemory_abs, ORA)
+CPU6502_OPERATION(0x0E, ReadModifyWrite_abs, RMW_ASL)
+CPU6502_OPERATION(0x15, InternalExecutionMemory_zpgX, ORA)
+CPU6502_OPERATION(0x16, ReadModifyWrite_zpgX, RMW_ASL)
+CPU6502_INSTRUCTION(0x18, CLC)
+CPU6502_OPERATION(0x19, InternalExecutionMemory_absY, ORA)
+CPU6502_OPERATION(0x1D, InternalExecutionMemory_absX, ORA)
+CPU6502_OPERATION(0x1E, ReadModifyWrite_absX, RMW_ASL)
+CPU6502_INSTRUCTION(0x20, JSR)
+CPU6502_OPERATION(0x21, InternalExecutionMemory_indX, AND)
+CPU6502_OPERATION(0x24, InternalExecutionMemory_zpg, BIT)
+CPU6502_OPERATION(0x25, InternalExecutionMemory_zpg, AND)
+CPU6502_OPERATION(0x26, ReadModifyWrite_zpg, RMW_ROL)
+CPU6502_OPERATION(0x28, StackPull, PLP)
+CPU6502_OPERATION(0x29, InternalExecutionMemory_imm, AND)
+CPU6502_INSTRUCTION(0x2A, Accum_ROL)
+CPU6502_OPERATION(0x2C, InternalExecutionMemory_abs, BIT)
+CPU6502_OPERATION(0x2D, InternalExecutionMemory_abs, AND)
+CPU6502_OPERATION(0x2E, ReadModifyWrite_abs, RMW_ROL)
+CPU6502_OPERATION(0x30, Branch, BMI)
+CPU6502_OPERATION(0x31, InternalExecutionMemory_indY, AND)
+CPU6502_OPERATION(0x35, InternalExecutionMemory_zpgX, AND)
+CPU6502_OPERATION(0x36, ReadModifyWrite_zpgX, RMW_ROL)
+CPU6502_INSTRUCTION(0x38, SEC)
+CPU6502_OPERATION(0x39, InternalExecutionMemory_absY, AND)
+CPU6502_OPERATION(0x3D, InternalExecutionMemory_absX, AND)
+CPU6502_OPERATION(0x3E, ReadModifyWrite_absX, RMW_ROL)
+CPU6502_INSTRUCTION(0x40, RTI)
+CPU6502_OPERATION(0x41, InternalExecutionMemory_indX, EOR)
+CPU6502_OPERATION(0x45, InternalExecutionMemory_zpg, EOR)
+CPU6502_OPERATION(0x46, ReadModifyWrite_zpg, RMW_LSR)
+CPU6502_OPERATION(0x48, StackPush, PHA)
+CPU6502_OPERATION(0x49, InternalExecutionMemory_imm, EOR)
+CPU6502_INSTRUCTION(0x4A, Accum_LSR)
+CPU6502_INSTRUCTION(0x4C, JMP_abs)
+CPU6502_OPERATION(0x4D, InternalExecutionMemory_abs, EOR)
+CPU6502_OPERATION(0x4E, ReadModifyWrite_abs, RMW_LSR)
+CPU6502_OPERATION(0x50, Branch, BVC)
+CPU6502_OPERATION(0x51, InternalExecutionMemory_indY, EOR)
+CPU6502_OPERATION(0x55, InternalExecutionMemory_zpgX, EOR)
+CPU6502_OPERATION(0x56, ReadModifyWrite_zpgX, RMW_LSR)
+CPU6502_INSTRUCTION(0x58, CLI)
+CPU6502_OPERATION(0x59, InternalExecutionMemory_absY, EOR)
+CPU6502_OPERATION(0x5D, InternalExecutionMemory_absX, EOR)
+CPU6502_OPERATION(0x5E, ReadModifyWrite_absX, RMW_LSR)
+CPU6502_INSTRUCTION(0x60, RTS)
+CPU6502_OPERATION(0x61, InternalExecutionMemory_indX, ADC)
+CPU6502_OPERATION(0x65, InternalExecutionMemory_zpg, ADC)
+CPU6502_OPERATION(0x66, ReadModifyWrite_zpg, RMW_ROR)
+CPU6502_OPERATION(0x68, StackPull, PLA)
+CPU6502_OPERATION(0x69, InternalExecutionMemory_imm, ADC)
+CPU6502_OPERATION(0x70, Branch, BVS)
+CPU6502_INSTRUCTION(0x6A, Accum_ROR)
+CPU6502_INSTRUCTION(0x6C, JMP_ind)
+CPU6502_OPERATION(0x6D, InternalExecutionMemory_abs, ADC)
+CPU6502_OPERATION(0x6E, ReadModifyWrite_abs, RMW_ROR)
+CPU6502_OPERATION(0x71, InternalExecutionMemory_indY, ADC)
+CPU6502_OPERATION(0x75, InternalExecutionMemory_zpgX, ADC)
+CPU6502_OPERATION(0x76, ReadModifyWrite_zpgX, RMW_ROR)
+CPU6502_INSTRUCTION(0x78, SEI)
+CPU6502_OPERATION(0x79, InternalExecutionMemory_absY, ADC)
+CPU6502_OPERATION(0x7D, InternalExecutionMemory_absX, ADC)
+CPU6502_OPERATION(0x7E, ReadModifyWrite_absX, RMW_ROR)
+CPU6502_OPERATION(0x81, Store_indX, STA)
+CPU6502_OPERATION(0x84, Store_zpg, STY)
+CPU6502_OPERATION(0x85, Store_zpg, STA)
+CPU6502_OPERATION(0x86, Store_zpg, STX)
+CPU6502_INSTRUCTION(0x88, DEY)
+CPU6502_INSTRUCTION(0x8A, TXA)
+CPU6502_OPERATION(0x8C, Store_abs, STY)
+CPU6502_OPERATION(0x8D, Store_abs, STA)
+CPU6502_OPERATION(0x8E, Store_abs, STX)
+CPU6502_OPERATION(0x90, Branch, BCC)
+CPU6502_OPERATION(0x91, Store_indY, STA)
+CPU6502_OPERATION(0x94, Store_zpgX, STY)
+CPU6502_OPERATION(0x95, Store_zpgX, STA)
+CPU6502_OPERATION(0x96, Store_zpgY, STX)
+CPU6502_INSTRUCTION(0x98, TYA)
+CPU6502_OPERATION(0x99, Store_absY, STA)
+CPU6502_INSTRUCTION(0x9A, TXS)
+CPU6502_OPERATION(0x9D, Store_absX, STA)
+CPU6502_OPERATION(0xA0, InternalExecutionMemory_imm, LDY)
+CPU6502_OPERATION(0xA1, InternalExecutionMemory_indX, LDA)
+CPU6502_OPERATION(0xA2, InternalExecutionMemory_imm, LDX)
+CPU6502_OPERATION(0xA4, InternalExecutionMemory_zpg, LDY)
+CPU6502_OPERATION(0xA5, InternalExecutionMemory_zpg, LDA)
+CPU6502_OPERATION(0xA6, InternalExecutionMemory_zpg, LDX)
+CPU6502_INSTRUCTION(0xA8, TAY)
+CPU6502_OPERATION(0xA9, InternalExecutionMemory_imm, LDA)
+CPU6502_INSTRUCTION(0xAA, TAX)
+CPU6502_OPERATION(0xAC, InternalExecutionMemory_abs, LDY)
+CPU6502_OPERATION(0xAD, InternalExecutionMemory_abs, LDA)
+CPU6502_OPERATION(0xAE, InternalExecutionMemory_abs, LDX)
+CPU6502_OPERATION(0xB0, Branch, BCS)
+CPU6502_OPERATION(0xB1, InternalExecutionMemory_indY, LDA)
+CPU6502_OPERATION(0xB4, InternalExecutionMemory_zpgX, LDY)
+CPU6502_OPERATION(0xB5, InternalExecutionMemory_zpgX, LDA)
+CPU6502_OPERATION(0xB6, InternalExecutionMemory_zpgY, LDX)
+CPU6502_INSTRUCTION(0xB8, CLV)
+CPU6502_OPERATION(0xB9, InternalExecutionMemory_absY, LDA)
+CPU6502_INSTRUCTION(0xBA, TSX)
+CPU6502_OPERATION(0xBC, InternalExecutionMemory_absX, LDY)
+CPU6502_OPERATION(0xBD, InternalExecutionMemory_absX, LDA)
+CPU6502_OPERATION(0xBE, InternalExecutionMemory_absY, LDX)
+CPU6502_OPERATION(0xC0, InternalExecutionMemory_imm, CPY)
+CPU6502_OPERATION(0xC1, InternalExecutionMemory_indX, CMP)
+CPU6502_OPERATION(0xC4, InternalExecutionMemory_zpg, CPY)
+CPU6502_OPERATION(0xC5, InternalExecutionMemory_zpg, CMP)
+CPU6502_OPERATION(0xC6, ReadModifyWrite_zpg, RMW_DEC)
+CPU6502_INSTRUCTION(0xC8, INY)
+CPU6502_OPERATION(0xC9, InternalExecutionMemory_imm, CMP)
+CPU6502_INSTRUCTION(0xCA, DEX)
+CPU6502_OPERATION(0xCC, InternalExecutionMemory_abs, CPY)
+CPU6502_OPERATION(0xCD, InternalExecutionMemory_abs, CMP)
+CPU6502_OPERATION(0xCE, ReadModifyWrite_abs, RMW_DEC)
+CPU6502_OPERATION(0xD0, Branch, BNE)
+CPU6502_OPERATION(0xD1, InternalExecutionMemory_indY, CMP)
+CPU6502_OPERATION(0xD5, InternalExecutionMemory_zpgX, CMP)
+CPU6502_OPERATION(0xD6, ReadModifyWrite_zpgX, RMW_DEC)
+CPU6502_INSTRUCTION(0xD8, CLD)
+CPU6502_OPERATION(0xD9, InternalExecutionMemory_absY, CMP)
+CPU6502_OPERATION(0xDD, InternalExecutionMemory_absX, CMP)
+CPU6502_OPERATION(0xDE, ReadModifyWrite_absX, RMW_DEC)
+CPU6502_OPERATION(0xE0, InternalExecutionMemory_imm, CPX)
+CPU6502_OPERATION(0xE1, InternalExecutionMemory_indX, SBC)
+CPU6502_OPERATION(0xE4, InternalExecutionMemory_zpg, CPX)
+CPU6502_OPERATION(0xE5, InternalExecutionMemory_zpg, SBC)
+CPU6502_OPERATION(0xE9, InternalExecutionMemory_imm, SBC)
+CPU6502_INSTRUCTION(0xEA, NOP)
+CPU6502_OPERATION(0xEC, InternalExecutionMemory_abs, CPX)
+CPU6502_OPERATION(0xED, InternalExecutionMemory_abs, SBC)
+CPU6502_OPERATION(0xE6, ReadModifyWrite_zpg, RMW_INC)
+CPU6502_INSTRUCTION(0xE8, INX)
+CPU6502_OPERATION(0xEE, ReadModifyWrite_abs, RMW_INC)
+CPU6502_OPERATION(0xF0, Branch, BEQ)
+CPU6502_OPERATION(0xF1, InternalExecutionMemory_indY, SBC)
+CPU6502_OPERATION(0xF5, InternalExecutionMemory_zpgX, SBC)
+CPU6502_OPERATION(0xF6, ReadModifyWrite_zpgX, RMW_INC)
+CPU6502_INSTRUCTION(0xF8, SED)
+CPU6502_OPERATION(0xF9, InternalExecutionMemory_absY, SBC)
+CPU6502_OPERATION(0xFD, InternalExecutionMemory_absX, SBC)
+CPU6502_OPERATION(0xFE, ReadModifyWrite_absX, RMW_INC)
+
+// Those extra NOPs across address modes
+CPU6502_NOP(0x1A, NOP_IMPLIED_1_2)
+CPU6502_NOP(0x3A, NOP_IMPLIED_1_2)
+CPU6502_NOP(0x5A, NOP_IMPLIED_1_2)
+CPU6502_NOP(0x7A, NOP_IMPLIED_1_2)
+CPU6502_NOP(0xDA, NOP_IMPLIED_1_2)
+CPU6502_NOP(0xFA, NOP_IMPLIED_1_2)
+
+CPU6502_NOP(0x80, NOP_IMMEDIATE_2_2)
+CPU6502_NOP(0x82, NOP_IMMEDIATE_2_2)
+CPU6502_NOP(0x89, NOP_IMMEDIATE_2_2)
+CPU6502_NOP(0xC2, NOP_IMMEDIATE_2_2)
+CPU6502_NOP(0xE2, NOP_IMMEDIATE_2_2)
+
+CPU6502_NOP(0x04, NOP_ZEROPAGE_2_3)
+CPU6502_NOP(0x44, NOP_ZEROPAGE_2_3)
+CPU6502_NOP(0x64, NOP_ZEROPAGE_2_3)
+
+CPU6502_NOP(0x14, NOP_ZEROPAGE_X_2_4)
+CPU6502_NOP(0x34, NOP_ZEROPAGE_X_2_4)
+CPU6502_NOP(0x54, NOP_ZEROPAGE_X_2_4)
+CPU6502_NOP(0x74, NOP_ZEROPAGE_X_2_4)
+CPU6502_NOP(0xD4, NOP_ZEROPAGE_X_2_4)
+CPU6502_NOP(0xF4, NOP_ZEROPAGE_X_2_4)
+
+CPU6502_NOP(0x0C, NOP_ABSOLUTE_3_4)
+
+CPU6502_NOP(0x1C, NOP_ABSOLUTE_X_3_4_1)
+CPU6502_NOP(0x3C, NOP_ABSOLUTE_X_3_4_1)
+CPU6502_NOP(0x5C, NOP_ABSOLUTE_X_3_4_1)
+CPU6502_NOP(0x7C, NOP_ABSOLUTE_X_3_4_1)
+CPU6502_NOP(0xDC, NOP_ABSOLUTE_X_3_4_1)
+CPU6502_NOP(0xFC, NOP_ABSOLUTE_X_3_4_1)
+
+#undef CPU6502_INSTRUCTION
+#undef CPU6502_OPERATION
+#undef CPU6502_NOP
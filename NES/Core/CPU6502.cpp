@@ -12,6 +12,13 @@
 const uint8_t kTnNextOpCodeFetch    = 0xFF;
 const uint8_t kTnOpCodeMax          = 0xFE;
 
+// m_plainMemory page flags
+const uint8_t kPlainMemoryRead      = 1 << 0;
+const uint8_t kPlainMemoryWrite     = 1 << 1;
+
+// Idle loops are at most this many bytes from their start to the jump back
+const uint16_t kIdleLoopMaxBytes    = 16;
+
 enum StatusFlag : uint8_t
 {
     Flag_Carry      = 1 << 0,       // unsigned overflow / underflow
@@ -66,7 +73,15 @@ CPU6502::CPU6502(IOBus& bus)
 , m_bSignalIRQ(false)
 , m_bSignalNMI(false)
 , m_bBranch(false)
-{
+, m_bIdleLoopWatch(false)
+, m_idleLoopStart(0)
+, m_idleLoopWatchStatusAddress(0)
+, m_idleLoopStatusAddress(0)
+, m_idleLoopTickCount(0)
+, m_idleLoopTicks(0)
+{
+    memset(m_plainMemory, 0x00, sizeof(m_plainMemory));
+    memset(m_idleLoopRegisters, 0x00, sizeof(m_idleLoopRegisters));
     InitInstructions();
 }
 
@@ -97,6 +112,11 @@ void CPU6502::Load(Archive& rArchive)
     rArchive >> m_bSignalIRQ;
     rArchive >> m_bSignalNMI;
     rArchive >> m_bBranch;
+    
+    m_bIdleLoopWatch = false;
+    m_idleLoopTicks = 0;
+    
+    UpdatePlainMemory();
 }
 
 void CPU6502::Save(Archive& rArchive) const
@@ -179,6 +199,11 @@ void CPU6502::PowerOn()
     
     m_bSignalIRQ = m_bSignalNMI = m_bSignalReset = false;
     m_bBranch = false;
+    
+    m_bIdleLoopWatch = false;
+    m_idleLoopTicks = 0;
+    
+    UpdatePlainMemory();
 }
 
 void CPU6502::Reset()
@@ -217,13 +242,260 @@ uint8_t CPU6502::programCounterReadByte()
 {
     return m_bus.cpuRead(m_pc++);
 }
+
+void CPU6502::UpdatePlainMemory()
+{
+    for(uint32_t page = 0;page < 256;++page)
+    {
+        uint8_t flags = 0;
+        if(m_bus.cpuPlainMemoryPage(uint8_t(page), false))
+        {
+            flags |= kPlainMemoryRead;
+        }
+        if(m_bus.cpuPlainMemoryPage(uint8_t(page), true))
+        {
+            flags |= kPlainMemoryWrite;
+        }
+        m_plainMemory[page] = flags;
+    }
+}
+
+bool CPU6502::PlainMemoryPage(uint16_t address, uint8_t access) const
+{
+    return (m_plainMemory[address >> 8] & access) == access;
+}
+
+// Only used on plain memory so reading ahead has no side effects
+uint16_t CPU6502::PeekAddress(uint16_t address)
+{
+    uint8_t addressL = m_bus.cpuRead(address);
+    uint8_t addressH = m_bus.cpuRead(address + 1);
+    return uint16FromRegisterPair(addressH, addressL);
+}
+
+// Called after the op code fetch - work out every address the rest of the instruction will touch
+bool CPU6502::PlainMemoryInstruction()
+{
+    const uint8_t memoryAccess = m_Instructions[m_opCode].m_memoryAccess;
+    const uint8_t addressMode = memoryAccess & ~MemoryAccess_Write;
+    const uint8_t access = (memoryAccess & MemoryAccess_Write) != 0 ? kPlainMemoryRead | kPlainMemoryWrite : kPlainMemoryRead;
+    
+    // Operands
+    if(addressMode == MemoryAccess_CycleStepped || !PlainMemoryPage(m_pc, kPlainMemoryRead) || !PlainMemoryPage(m_pc + 1, kPlainMemoryRead))
+    {
+        return false;
+    }
+    
+    switch(addressMode)
+    {
+        case MemoryAccess_None:
+        {
+            return true;
+        }
+        case MemoryAccess_Stack:
+        {
+            return PlainMemoryPage(0x0100, kPlainMemoryRead | kPlainMemoryWrite);
+        }
+        case MemoryAccess_ZeroPage:
+        {
+            return PlainMemoryPage(0x0000, access);
+        }
+        case MemoryAccess_Absolute:
+        {
+            return PlainMemoryPage(PeekAddress(m_pc), access);
+        }
+        case MemoryAccess_AbsoluteX:
+        case MemoryAccess_AbsoluteY:
+        {
+            // Dummy read can be on the base page before the carry
+            const uint16_t baseAddress = PeekAddress(m_pc);
+            const uint16_t effectiveAddress = baseAddress + (addressMode == MemoryAccess_AbsoluteX ? m_x : m_y);
+            return PlainMemoryPage(baseAddress, kPlainMemoryRead) && PlainMemoryPage(effectiveAddress, access);
+        }
+        case MemoryAccess_IndirectX:
+        {
+            if(!PlainMemoryPage(0x0000, kPlainMemoryRead))
+            {
+                return false;
+            }
+            const uint8_t pointer = m_bus.cpuRead(m_pc) + m_x;
+            const uint16_t effectiveAddress = uint16FromRegisterPair(m_bus.cpuRead(uint8_t(pointer + 1)), m_bus.cpuRead(pointer));
+            return PlainMemoryPage(effectiveAddress, access);
+        }
+        case MemoryAccess_IndirectY:
+        {
+            if(!PlainMemoryPage(0x0000, kPlainMemoryRead))
+            {
+                return false;
+            }
+            const uint8_t pointer = m_bus.cpuRead(m_pc);
+            const uint16_t baseAddress = uint16FromRegisterPair(m_bus.cpuRead(uint8_t(pointer + 1)), m_bus.cpuRead(pointer));
+            const uint16_t effectiveAddress = baseAddress + m_y;
+            return PlainMemoryPage(baseAddress, kPlainMemoryRead) && PlainMemoryPage(effectiveAddress, access);
+        }
+        case MemoryAccess_JumpIndirect:
+        {
+            // Both pointer bytes are on the same page
+            return PlainMemoryPage(PeekAddress(m_pc), kPlainMemoryRead);
+        }
+    }
+    
+    return false;
+}
+    
+#if CPU6502_SWITCH_DISPATCH
+
+// Direct calls the compiler can see through instead of member function pointers - same table as InitInstructions
+bool CPU6502::ExecuteInstruction()
+{
+    switch(m_opCode)
+    {
+#define CPU6502_INSTRUCTION(opCode, handler)                case opCode: return handler();
+#define CPU6502_OPERATION(opCode, addressMode, operation)   case opCode: return addressMode<&CPU6502::operation>();
+#define CPU6502_NOP(opCode, handler)                        case opCode: return handler();
+#include "CPU6502-ITable.h"
+        default:
+            return HandleError();
+    }
+}
+
+uint8_t CPU6502::RunInstruction()
+{
+    switch(m_opCode)
+    {
+#define CPU6502_INSTRUCTION(opCode, handler)                case opCode: return RunTStates<&CPU6502::handler>();
+#define CPU6502_OPERATION(opCode, addressMode, operation)   case opCode: return RunTStates<&CPU6502::addressMode<&CPU6502::operation>>();
+#define CPU6502_NOP(opCode, handler)                        case opCode: return RunTStates<&CPU6502::handler>();
+#include "CPU6502-ITable.h"
+        default:
+            // Unknown op codes are always cycle stepped
+            return 0;
+    }
+}
+
+#else
+
+bool CPU6502::ExecuteInstruction()
+{
+    return (this->*(m_Instructions[m_opCode].m_opOrAddrMode))();
+}
+
+uint8_t CPU6502::RunInstruction()
+{
+    return (this->*(m_Instructions[m_opCode].m_runInstruction))();
+}
+
+#endif
+
+template<bool(CPU6502::*handler)()>
+uint8_t CPU6502::RunTStates()
+{
+    // The same T states Tick would step through one at a time - starts at T1 after the op code fetch
+    uint8_t tickCount = 1;
+    while((this->*handler)() == false)
+    {
+        ++m_Tn;
+        ++tickCount;
+    }
+    return tickCount;
+}
+
+uint8_t CPU6502::TickInstruction()
+{
+    const bool bOpCodeFetch = m_Tn == kTnNextOpCodeFetch;
+    
+    Tick();
+    
+    // Anything that can touch IO registers is cycle stepped so each access lands on the right cycle
+    if(bOpCodeFetch && m_Tn == 1 && PlainMemoryInstruction())
+    {
+        const uint16_t opCodePC = m_pc - 1;
+        const uint8_t tickCount = RunInstruction();
+        m_Tn = kTnNextOpCodeFetch;
+        m_tickCount += tickCount;
+        
+        // Jumped a short way back - could be the end of a loop that is only waiting
+        if(uint16_t(opCodePC - m_pc) < kIdleLoopMaxBytes)
+        {
+            IdleLoopJump();
+        }
+        
+        return tickCount + 1;
+    }
+    
+    return 1;
+}
+
+void CPU6502::IdleLoopJump()
+{
+    const uint8_t registers[] = { m_a, m_x, m_y, m_stack, m_flags };
+    const bool bSignal = m_bSignalReset || m_bSignalNMI || (m_bSignalIRQ && TestFlag(Flag_IRQDisable) == false);
     
+    // Back to the same start with the same registers, only having read - each time round is the same while what it reads is
+    m_idleLoopTicks = 0;
+    if(m_bIdleLoopWatch && m_pc == m_idleLoopStart && !bSignal && memcmp(registers, m_idleLoopRegisters, sizeof(registers)) == 0)
+    {
+        const uint64_t tickCount = m_tickCount - m_idleLoopTickCount;
+        if(tickCount <= 0xFF)
+        {
+            m_idleLoopTicks = uint8_t(tickCount);
+        }
+    }
+    
+    m_idleLoopStatusAddress = m_idleLoopWatchStatusAddress;
+    
+    // Watch the next time round
+    m_bIdleLoopWatch = true;
+    m_idleLoopStart = m_pc;
+    m_idleLoopWatchStatusAddress = 0;
+    m_idleLoopTickCount = m_tickCount;
+    memcpy(m_idleLoopRegisters, registers, sizeof(registers));
+}
+
+void CPU6502::WatchIdleLoop()
+{
+    // Called on each op code fetch while watching - everything in the loop reads, from inside the loop
+    const uint16_t opCodePC = m_pc - 1;
+    const uint8_t memoryAccess = m_Instructions[m_opCode].m_memoryAccess;
+    bool bIdle = uint16_t(opCodePC - m_idleLoopStart) < kIdleLoopMaxBytes && (memoryAccess & MemoryAccess_Write) == 0 && memoryAccess != MemoryAccess_Stack;
+    
+    if(bIdle && !PlainMemoryInstruction())
+    {
+        // Apart from plain memory only one status register can be read
+        bIdle = false;
+        if(memoryAccess == MemoryAccess_Absolute && PlainMemoryPage(m_pc, kPlainMemoryRead) && PlainMemoryPage(m_pc + 1, kPlainMemoryRead))
+        {
+            const uint16_t address = PeekAddress(m_pc);
+            if(m_bus.cpuStatusRegister(address) && (m_idleLoopWatchStatusAddress == 0 || m_idleLoopWatchStatusAddress == address))
+            {
+                m_idleLoopWatchStatusAddress = address;
+                bIdle = true;
+            }
+        }
+    }
+    
+    if(!bIdle)
+    {
+        m_bIdleLoopWatch = false;
+    }
+}
+
+void CPU6502::SkipIdleLoop(uint32_t iterationCount)
+{
+    const uint64_t tickCount = uint64_t(iterationCount) * m_idleLoopTicks;
+    m_tickCount += tickCount;
+    
+    // The time round being watched now started from the same place
+    m_idleLoopTickCount += tickCount;
+    m_idleLoopTicks = 0;
+}
+
 void CPU6502::Tick()
 {
     // Some instructions perform final executation during next op code fetch
     if(m_Tn == kTnNextOpCodeFetch && m_tickCount > 0)
     {
-        (this->*(m_Instructions[m_opCode].m_opOrAddrMode))();
+        ExecuteInstruction();
     }
 
     bool bInstructionTStatesCompleted = false;
@@ -247,6 +519,7 @@ void CPU6502::Tick()
             // External signal detected
             m_opCode = 0;
             ClearFlag(Flag_Break);
+            m_bIdleLoopWatch = false;
         }
         else
         {
@@ -256,11 +529,16 @@ void CPU6502::Tick()
             {
                 SetFlag(Flag_Break);
             }
+            
+            if(m_bIdleLoopWatch)
+            {
+                WatchIdleLoop();
+            }
         }
     }
     else if(m_Tn <= kTnOpCodeMax)
     {
-        bInstructionTStatesCompleted = (this->*(m_Instructions[m_opCode].m_opOrAddrMode))();
+        bInstructionTStatesCompleted = ExecuteInstruction();
     }
     
     if(bInstructionTStatesCompleted)
@@ -582,6 +860,7 @@ void CPU6502::RMW_ROR()
     ROR(m_dataBus);
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::ReadModifyWrite_zpg()
 {
     if(m_Tn == 1)
@@ -600,13 +879,14 @@ bool CPU6502::ReadModifyWrite_zpg()
     }
     else if(m_Tn == 4)
     {
-        (this->*(m_Instructions[m_opCode].m_operation))();
+        (this->*operation)();
         addressBusWriteByte(m_dataBus);
         return true;
     }
     return false;
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::ReadModifyWrite_abs()
 {
     if(m_Tn == 1)
@@ -629,13 +909,14 @@ bool CPU6502::ReadModifyWrite_abs()
     }
     else if(m_Tn == 5)
     {
-        (this->*(m_Instructions[m_opCode].m_operation))();
+        (this->*operation)();
         addressBusWriteByte(m_dataBus);
         return true;
     }
     return false;
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::ReadModifyWrite_zpgX()
 {
     if(m_Tn == 1)
@@ -659,13 +940,14 @@ bool CPU6502::ReadModifyWrite_zpgX()
     }
     else if(m_Tn == 5)
     {
-        (this->*(m_Instructions[m_opCode].m_operation))();
+        (this->*operation)();
         addressBusWriteByte(m_dataBus);
         return true;
     }
     return false;
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::ReadModifyWrite_absX()
 {
     if(m_Tn == 1)
@@ -697,7 +979,7 @@ bool CPU6502::ReadModifyWrite_absX()
     }
     else if(m_Tn == 6)
     {
-        (this->*(m_Instructions[m_opCode].m_operation))();
+        (this->*operation)();
         addressBusWriteByte(m_dataBus);
         return true;
     }
@@ -799,6 +1081,7 @@ void CPU6502::LDY()
     REG_LOAD(m_y);
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::InternalExecutionMemory_imm()
 {
     if(m_Tn == 1)
@@ -808,12 +1091,13 @@ bool CPU6502::InternalExecutionMemory_imm()
     }
     else if(m_Tn == kTnNextOpCodeFetch)
     {
-        (this->*(m_Instructions[m_opCode].m_operation))();
+        (this->*operation)();
         return true;
     }
     return false;
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::InternalExecutionMemory_zpg()
 {
     if(m_Tn == 1)
@@ -829,12 +1113,13 @@ bool CPU6502::InternalExecutionMemory_zpg()
     }
     else if(m_Tn == kTnNextOpCodeFetch)
     {
-        (this->*(m_Instructions[m_opCode].m_operation))();
+        (this->*operation)();
         return true;
     }
     return false;
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::InternalExecutionMemory_abs()
 {
     if(m_Tn == 1)
@@ -854,12 +1139,13 @@ bool CPU6502::InternalExecutionMemory_abs()
     }
     else if(m_Tn == kTnNextOpCodeFetch)
     {
-        (this->*(m_Instructions[m_opCode].m_operation))();
+        (this->*operation)();
         return true;
     }
     return false;
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::InternalExecutionMemory_indX()
 {
     if(m_Tn == 1)
@@ -893,14 +1179,17 @@ bool CPU6502::InternalExecutionMemory_indX()
     }
     else if(m_Tn == kTnNextOpCodeFetch)
     {
-        (this->*(m_Instructions[m_opCode].m_operation))();
+        (this->*operation)();
         return true;
     }
     return false;
 }
 
-bool CPU6502::InternalExecutionMemory_absREG(uint8_t& cpuReg)
+template<CPU6502::OperationFunc operation, uint8_t CPU6502::*reg>
+bool CPU6502::InternalExecutionMemory_absREG()
 {
+    uint8_t& cpuReg = this->*reg;
+    
     if(m_Tn == 1)
     {
         m_dataBus = programCounterReadByte();
@@ -930,24 +1219,29 @@ bool CPU6502::InternalExecutionMemory_absREG(uint8_t& cpuReg)
     }
     else if(m_Tn == kTnNextOpCodeFetch)
     {
-        (this->*(m_Instructions[m_opCode].m_operation))();
+        (this->*operation)();
         return true;
     }
     return false;
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::InternalExecutionMemory_absX()
 {
-    return InternalExecutionMemory_absREG(m_x);
+    return InternalExecutionMemory_absREG<operation, &CPU6502::m_x>();
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::InternalExecutionMemory_absY()
 {
-    return InternalExecutionMemory_absREG(m_y);
+    return InternalExecutionMemory_absREG<operation, &CPU6502::m_y>();
 }
 
-bool CPU6502::InternalExecutionMemory_zpgREG(uint8_t& cpuReg)
+template<CPU6502::OperationFunc operation, uint8_t CPU6502::*reg>
+bool CPU6502::InternalExecutionMemory_zpgREG()
 {
+    uint8_t& cpuReg = this->*reg;
+    
     if(m_Tn == 1)
     {
         m_dataBus = programCounterReadByte();
@@ -966,22 +1260,25 @@ bool CPU6502::InternalExecutionMemory_zpgREG(uint8_t& cpuReg)
     }
     else if(m_Tn == kTnNextOpCodeFetch)
     {
-        (this->*(m_Instructions[m_opCode].m_operation))();
+        (this->*operation)();
         return true;
     }
     return false;
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::InternalExecutionMemory_zpgX()
 {
-    return InternalExecutionMemory_zpgREG(m_x);
+    return InternalExecutionMemory_zpgREG<operation, &CPU6502::m_x>();
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::InternalExecutionMemory_zpgY()
 {
-    return InternalExecutionMemory_zpgREG(m_y);
+    return InternalExecutionMemory_zpgREG<operation, &CPU6502::m_y>();
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::InternalExecutionMemory_indY()
 {
     if(m_Tn == 1)
@@ -1019,7 +1316,7 @@ bool CPU6502::InternalExecutionMemory_indY()
     }
     else if(m_Tn == kTnNextOpCodeFetch)
     {
-        (this->*(m_Instructions[m_opCode].m_operation))();
+        (this->*operation)();
         return true;
     }
     return false;
@@ -1040,6 +1337,7 @@ void CPU6502::STY()
      m_dataBus = m_y;
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::Store_zpg()
 {
     if(m_Tn == 1)
@@ -1051,7 +1349,7 @@ bool CPU6502::Store_zpg()
         m_addressBusH = 0;
         m_addressBusL = m_dataBus;
         
-        (this->*(m_Instructions[m_opCode].m_operation))();
+        (this->*operation)();
         addressBusWriteByte(m_dataBus);
         
         return true;
@@ -1059,6 +1357,7 @@ bool CPU6502::Store_zpg()
     return false;
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::Store_abs()
 {
     if(m_Tn == 1)
@@ -1074,7 +1373,7 @@ bool CPU6502::Store_abs()
     {
         m_addressBusH = m_dataBus;
         
-        (this->*(m_Instructions[m_opCode].m_operation))();
+        (this->*operation)();
         addressBusWriteByte(m_dataBus);
         
         return true;
@@ -1082,6 +1381,7 @@ bool CPU6502::Store_abs()
     return false;
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::Store_indX()
 {
     if(m_Tn == 1)
@@ -1111,7 +1411,7 @@ bool CPU6502::Store_indX()
         m_addressBusH = m_effectiveAddressH;
         m_addressBusL = m_effectiveAddressL;
         
-        (this->*(m_Instructions[m_opCode].m_operation))();
+        (this->*operation)();
         addressBusWriteByte(m_dataBus);
         
         return true;
@@ -1119,8 +1419,11 @@ bool CPU6502::Store_indX()
     return false;
 }
 
-bool CPU6502::Store_absREG(uint8_t& cpuReg)
+template<CPU6502::OperationFunc operation, uint8_t CPU6502::*reg>
+bool CPU6502::Store_absREG()
 {
+    uint8_t& cpuReg = this->*reg;
+    
     if(m_Tn == 1)
     {
         m_dataBus = programCounterReadByte();
@@ -1139,7 +1442,7 @@ bool CPU6502::Store_absREG(uint8_t& cpuReg)
     }
     else if(m_Tn == 4)
     {
-        (this->*(m_Instructions[m_opCode].m_operation))();
+        (this->*operation)();
         addressBusWriteByte(m_dataBus);
         
         return true;
@@ -1147,18 +1450,23 @@ bool CPU6502::Store_absREG(uint8_t& cpuReg)
     return false;
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::Store_absX()
 {
-    return Store_absREG(m_x);
+    return Store_absREG<operation, &CPU6502::m_x>();
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::Store_absY()
 {
-    return Store_absREG(m_y);
+    return Store_absREG<operation, &CPU6502::m_y>();
 }
 
-bool CPU6502::Store_zpgREG(uint8_t& cpuReg)
+template<CPU6502::OperationFunc operation, uint8_t CPU6502::*reg>
+bool CPU6502::Store_zpgREG()
 {
+    uint8_t& cpuReg = this->*reg;
+    
     if(m_Tn == 1)
     {
         m_dataBus = programCounterReadByte();
@@ -1173,7 +1481,7 @@ bool CPU6502::Store_zpgREG(uint8_t& cpuReg)
     {
         m_addressBusL = m_baseAddressL + cpuReg;
         
-        (this->*(m_Instructions[m_opCode].m_operation))();
+        (this->*operation)();
         addressBusWriteByte(m_dataBus);
         
         return true;
@@ -1181,16 +1489,19 @@ bool CPU6502::Store_zpgREG(uint8_t& cpuReg)
     return false;
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::Store_zpgX()
 {
-    return Store_zpgREG(m_x);
+    return Store_zpgREG<operation, &CPU6502::m_x>();
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::Store_zpgY()
 {
-    return Store_zpgREG(m_y);
+    return Store_zpgREG<operation, &CPU6502::m_y>();
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::Store_indY()
 {
     if(m_Tn == 1)
@@ -1220,7 +1531,7 @@ bool CPU6502::Store_indY()
     }
     else if(m_Tn == 5)
     {
-        (this->*(m_Instructions[m_opCode].m_operation))();
+        (this->*operation)();
         addressBusWriteByte(m_dataBus);
         
         return true;
@@ -1254,6 +1565,7 @@ void CPU6502::PLA()
     ConditionalSetFlag(Flag_Negative, (m_a & (1 << 7)) != 0);
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::StackPush()
 {
     if(m_Tn == 2)
@@ -1261,7 +1573,7 @@ bool CPU6502::StackPush()
         m_addressBusH = 0x01;
         m_addressBusL = m_stack--;
         
-        (this->*(m_Instructions[m_opCode].m_operation))();
+        (this->*operation)();
         addressBusWriteByte(m_dataBus);
 
         return true;
@@ -1269,6 +1581,7 @@ bool CPU6502::StackPush()
     return false;
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::StackPull()
 {
     if(m_Tn == 3)
@@ -1277,7 +1590,7 @@ bool CPU6502::StackPull()
         m_addressBusL = ++m_stack;
         m_dataBus = addressBusReadByte();
         
-        (this->*(m_Instructions[m_opCode].m_operation))();
+        (this->*operation)();
         
         return true;
     }
@@ -1561,6 +1874,7 @@ void CPU6502::BVS()
     m_bBranch = TestFlag(Flag_Overflow) == true;
 }
 
+template<CPU6502::OperationFunc operation>
 bool CPU6502::Branch()
 {
     if(m_Tn == 1)
@@ -1568,7 +1882,7 @@ bool CPU6502::Branch()
         m_bBranch = false;
         m_dataBus = programCounterReadByte();
         
-        (this->*(m_Instructions[m_opCode].m_operation))();
+        (this->*operation)();
         
         // if branch not taken we are done
         return m_bBranch == false;
@@ -1702,3 +2016,23 @@ bool CPU6502::NOP_ABSOLUTE_X_3_4_1()
     
     return false;
 }
+
+// InitInstructions takes the address of every address mode and operation pairing - instantiate them here with the definitions
+#define CPU6502_INSTRUCTION(opCode, handler)
+#define CPU6502_OPERATION(opCode, addressMode, operation)   template bool CPU6502::addressMode<&CPU6502::operation>();
+#define CPU6502_NOP(opCode, handler)
+#include "CPU6502-ITable.h"
+
+// Likewise each op code's whole instruction runner
+#define CPU6502_INSTRUCTION(opCode, handler)                template uint8_t CPU6502::RunTStates<&CPU6502::handler>();
+#define CPU6502_OPERATION(opCode, addressMode, operation)   template uint8_t CPU6502::RunTStates<&CPU6502::addressMode<&CPU6502::operation>>();
+#define CPU6502_NOP(opCode, handler)
+#include "CPU6502-ITable.h"
+
+// NOP handlers are shared between op codes so can't come from the table
+template uint8_t CPU6502::RunTStates<&CPU6502::NOP_IMPLIED_1_2>();
+template uint8_t CPU6502::RunTStates<&CPU6502::NOP_IMMEDIATE_2_2>();
+template uint8_t CPU6502::RunTStates<&CPU6502::NOP_ZEROPAGE_2_3>();
+template uint8_t CPU6502::RunTStates<&CPU6502::NOP_ZEROPAGE_X_2_4>();
+template uint8_t CPU6502::RunTStates<&CPU6502::NOP_ABSOLUTE_3_4>();
+template uint8_t CPU6502::RunTStates<&CPU6502::NOP_ABSOLUTE_X_3_4_1>();
@@ -11,6 +11,11 @@
 #include "IOBus.h"
 #include "Serialise.h"
 
+// Instruction dispatch - 1 = switch over the opcode table, 0 = member function pointer table
+#ifndef CPU6502_SWITCH_DISPATCH
+    #define CPU6502_SWITCH_DISPATCH 0
+#endif
+
 class CPU6502 : public Serialisable
 {
 public:
@@ -23,6 +28,20 @@ public:
     void Reset();
     void Tick();
     
+    // Tick, then run the rest of the instruction at once when it only touches plain memory
+    // Returns the CPU ticks used - the caller skips all but the first
+    uint8_t TickInstruction();
+    
+    // Non zero just after a whole instruction jumped back to the start of an idle loop - the CPU ticks each time round
+    // An idle loop only reads plain memory and at most one status register, and came round last time to the same registers
+    uint8_t IdleLoopTicks() const { return m_idleLoopTicks; }
+    
+    // Status register the idle loop polls, 0 when it only reads plain memory
+    uint16_t IdleLoopStatusAddress() const { return m_idleLoopStatusAddress; }
+    
+    // Count iterations of the idle loop as already run - the caller runs the ticks for everything else
+    void SkipIdleLoop(uint32_t iterationCount);
+    
     void SignalReset(bool bSignal);
     void SignalNMI(bool bSignal);
     void SignalIRQ(bool bSignal);
@@ -37,6 +56,14 @@ private:
     uint8_t programCounterReadByte();
     uint8_t addressBusReadByte();
     void addressBusWriteByte(uint8_t data);
+    
+    void UpdatePlainMemory();
+    bool PlainMemoryPage(uint16_t address, uint8_t access) const;
+    bool PlainMemoryInstruction();
+    uint16_t PeekAddress(uint16_t address);
+    
+    void IdleLoopJump();
+    void WatchIdleLoop();
             
 private:
 
@@ -74,12 +101,45 @@ private:
     
     bool m_bBranch;
     
+    // Per page plain memory flags from the bus
+    uint8_t m_plainMemory[256];
+    
+    // Idle loop detection - each instruction from a short jump back is watched until the next jump back to the same place
+    bool m_bIdleLoopWatch;
+    uint16_t m_idleLoopStart;
+    uint16_t m_idleLoopWatchStatusAddress;
+    uint16_t m_idleLoopStatusAddress;
+    uint64_t m_idleLoopTickCount;
+    uint8_t m_idleLoopRegisters[5];                 // A, X, Y, stack, flags at the start
+    uint8_t m_idleLoopTicks;
+    
 private:
     
+    // Operations are template arguments of their address mode so each opcode gets its own specialised handler
+    typedef void(CPU6502::*OperationFunc)();
+    
+    // Memory an instruction touches beyond its op code and operands - decides if it can run in one go
+    enum MemoryAccess : uint8_t
+    {
+        MemoryAccess_CycleStepped = 0,  // BRK, interrupts and unknown op codes
+        MemoryAccess_None,
+        MemoryAccess_Stack,
+        MemoryAccess_ZeroPage,
+        MemoryAccess_Absolute,
+        MemoryAccess_AbsoluteX,
+        MemoryAccess_AbsoluteY,
+        MemoryAccess_IndirectX,
+        MemoryAccess_IndirectY,
+        MemoryAccess_JumpIndirect,
+        
+        MemoryAccess_Write = 1 << 7
+    };
+    
     struct CPUInstruction
     {
-        bool(CPU6502::*m_opOrAddrMode)()  = &CPU6502::HandleError;
-        void(CPU6502::*m_operation)()     = nullptr;
+        bool(CPU6502::*m_opOrAddrMode)()        = &CPU6502::HandleError;
+        uint8_t(CPU6502::*m_runInstruction)()   = nullptr;
+        uint8_t m_memoryAccess                  = MemoryAccess_CycleStepped;
     };
     CPUInstruction m_Instructions[256];
     
@@ -88,6 +148,13 @@ private:
     bool HandleError();
     void InitInstructions();
     
+    // Run the current T state of m_opCode, true when the instruction has completed
+    bool ExecuteInstruction();
+    
+    // Run the remaining T states of m_opCode, returns how many
+    uint8_t RunInstruction();
+    template<bool(CPU6502::*handler)()> uint8_t RunTStates();
+    
     // Address modes + their instructions
     void ASL(uint8_t& cpuReg); void LSR(uint8_t& cpuReg); void ROL(uint8_t& cpuReg); void ROR(uint8_t& cpuReg); void REG_CMP(uint8_t& cpuReg); void REG_LOAD(uint8_t& cpuReg);
     
@@ -99,29 +166,35 @@ private:
     
     void ADC(); void AND(); void BIT(); void CMP(); void CPX(); void CPY();
     void EOR(); void LDA(); void LDX(); void LDY(); void ORA(); void SBC();
-    bool InternalExecutionMemory_absREG(uint8_t& cpuReg);
-    bool InternalExecutionMemory_zpgREG(uint8_t& cpuReg);
-    bool InternalExecutionMemory_imm(); bool InternalExecutionMemory_zpg(); bool InternalExecutionMemory_abs();
-    bool InternalExecutionMemory_indX(); bool InternalExecutionMemory_indY(); bool InternalExecutionMemory_absX();
-    bool InternalExecutionMemory_absY(); bool InternalExecutionMemory_zpgX(); bool InternalExecutionMemory_zpgY();
+    template<OperationFunc operation, uint8_t CPU6502::*reg> bool InternalExecutionMemory_absREG();
+    template<OperationFunc operation, uint8_t CPU6502::*reg> bool InternalExecutionMemory_zpgREG();
+    template<OperationFunc operation> bool InternalExecutionMemory_imm(); template<OperationFunc operation> bool InternalExecutionMemory_zpg();
+    template<OperationFunc operation> bool InternalExecutionMemory_abs(); template<OperationFunc operation> bool InternalExecutionMemory_indX();
+    template<OperationFunc operation> bool InternalExecutionMemory_indY(); template<OperationFunc operation> bool InternalExecutionMemory_absX();
+    template<OperationFunc operation> bool InternalExecutionMemory_absY(); template<OperationFunc operation> bool InternalExecutionMemory_zpgX();
+    template<OperationFunc operation> bool InternalExecutionMemory_zpgY();
     
     void STA(); void STX(); void STY();
-    bool Store_absREG(uint8_t& cpuReg); bool Store_zpgREG(uint8_t& cpuReg);
-    bool Store_zpg(); bool Store_abs(); bool Store_absX(); bool Store_absY();
-    bool Store_zpgX(); bool Store_zpgY(); bool Store_indX(); bool Store_indY();
+    template<OperationFunc operation, uint8_t CPU6502::*reg> bool Store_absREG();
+    template<OperationFunc operation, uint8_t CPU6502::*reg> bool Store_zpgREG();
+    template<OperationFunc operation> bool Store_zpg(); template<OperationFunc operation> bool Store_abs();
+    template<OperationFunc operation> bool Store_absX(); template<OperationFunc operation> bool Store_absY();
+    template<OperationFunc operation> bool Store_zpgX(); template<OperationFunc operation> bool Store_zpgY();
+    template<OperationFunc operation> bool Store_indX(); template<OperationFunc operation> bool Store_indY();
     
     void RMW_ASL(); void RMW_DEC(); void RMW_INC(); void RMW_LSR(); void RMW_ROL(); void RMW_ROR();
-    bool ReadModifyWrite_zpg(); bool ReadModifyWrite_abs(); bool ReadModifyWrite_zpgX(); bool ReadModifyWrite_absX();
+    template<OperationFunc operation> bool ReadModifyWrite_zpg(); template<OperationFunc operation> bool ReadModifyWrite_abs();
+    template<OperationFunc operation> bool ReadModifyWrite_zpgX(); template<OperationFunc operation> bool ReadModifyWrite_absX();
     
     void PHP(); void PHA(); void PLP(); void PLA();
-    bool StackPush(); bool StackPull();
+    template<OperationFunc operation> bool StackPush(); template<OperationFunc operation> bool StackPull();
     
     void GenericPushStack(uint8_t data);
     uint8_t GenericPullStack();
     bool JSR(); bool RTS(); bool BRK(); bool RTI(); bool JMP_abs(); bool JMP_ind();
     
     void BCC(); void BCS(); void BEQ(); void BMI(); void BNE(); void BPL(); void BVC(); void BVS();
-    bool Branch();
+    template<OperationFunc operation> bool Branch();
     
     // Extra address mode NOPs FunctionName = Instruction_AddressMode_ByteCount_CycleCount[_(+1)]
     bool NOP_IMPLIED_1_2(); bool NOP_IMMEDIATE_2_2(); bool NOP_ZEROPAGE_2_3(); bool NOP_ZEROPAGE_X_2_4(); bool NOP_ABSOLUTE_3_4(); bool NOP_ABSOLUTE_X_3_4_1();
@@ -175,6 +175,7 @@ void Cartridge::Initialise(SystemIOBus& bus, const char* pCartPath)
         {
             m_pCartVRAM = new uint8_t[4096];
             memset(m_pCartVRAM, 0x00, 4096);
+            bus.SetCartVRAM(m_pCartVRAM);
         }
     }
 
@@ -480,6 +481,32 @@ uint16_t Cartridge::GetMapperID() const
     return 0xFFFF;
 }
 
+bool Cartridge::PPUBusSignalsIRQ() const
+{
+    if(m_pMapper != nullptr)
+    {
+        return m_pMapper->PPUBusSignalsIRQ();
+    }
+    return false;
+}
+
+bool Cartridge::TickSignalsIRQ() const
+{
+    if(m_pMapper != nullptr)
+    {
+        return m_pMapper->TickSignalsIRQ();
+    }
+    return false;
+}
+
+void Cartridge::ScheduleEvents()
+{
+    if(m_pMapper != nullptr)
+    {
+        m_pMapper->ScheduleEvents();
+    }
+}
+
 void Cartridge::SystemTick(uint64_t cycleCount)
 {
     if(m_pMapper != nullptr)
@@ -497,6 +524,15 @@ float Cartridge::AudioOut()
     return 0.f;
 }
 
+bool Cartridge::HasAudioOut()
+{
+    if(m_pMapper != nullptr)
+    {
+        return m_pMapper->HasAudioOut();
+    }
+    return false;
+}
+
 uint8_t Cartridge::cpuRead(uint16_t address)
 {
     if(m_pMapper != nullptr)
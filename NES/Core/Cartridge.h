@@ -27,9 +27,13 @@ public:
     
     bool IsValid() const;
     uint16_t GetMapperID() const;
+    bool PPUBusSignalsIRQ() const;
+    bool TickSignalsIRQ() const;
+    void ScheduleEvents();
     
     virtual void SystemTick(uint64_t cycleCount) override;
     virtual float AudioOut() override;
+    virtual bool HasAudioOut() override;
     
 private:
 
@@ -0,0 +1,128 @@
+//
+//  EventQueue.cpp
+//  NES
+//
+
+#include "EventQueue.h"
+
+SystemEventQueue::SystemEventQueue()
+: m_eventCount(0)
+, m_order(0)
+{}
+
+void SystemEventQueue::Clear()
+{
+    m_eventCount = 0;
+    m_order = 0;
+}
+
+bool SystemEventQueue::Before(const Event& a, const Event& b)
+{
+    if(a.m_cycleCount != b.m_cycleCount)
+    {
+        return a.m_cycleCount < b.m_cycleCount;
+    }
+    return a.m_order < b.m_order;
+}
+
+void SystemEventQueue::SiftUp(uint32_t index)
+{
+    while(index > 0)
+    {
+        uint32_t parent = (index - 1) / 2;
+        if(!Before(m_events[index], m_events[parent]))
+        {
+            break;
+        }
+
+        Event temp = m_events[parent];
+        m_events[parent] = m_events[index];
+        m_events[index] = temp;
+        index = parent;
+    }
+}
+
+void SystemEventQueue::SiftDown(uint32_t index)
+{
+    while(true)
+    {
+        uint32_t smallest = index;
+        uint32_t left = index * 2 + 1;
+        uint32_t right = left + 1;
+
+        if(left < m_eventCount && Before(m_events[left], m_events[smallest]))
+        {
+            smallest = left;
+        }
+        if(right < m_eventCount && Before(m_events[right], m_events[smallest]))
+        {
+            smallest = right;
+        }
+        if(smallest == index)
+        {
+            break;
+        }
+
+        Event temp = m_events[smallest];
+        m_events[smallest] = m_events[index];
+        m_events[index] = temp;
+        index = smallest;
+    }
+}
+
+void SystemEventQueue::Remove(uint32_t index)
+{
+    --m_eventCount;
+    if(index < m_eventCount)
+    {
+        m_events[index] = m_events[m_eventCount];
+        SiftUp(index);
+        SiftDown(index);
+    }
+}
+
+void SystemEventQueue::Schedule(SystemEventHandler* pHandler, uint32_t eventID, uint64_t cycleCount)
+{
+    Cancel(pHandler, eventID);
+
+    if(m_eventCount >= kMaxEvents)
+    {
+#if DEBUG
+        // Too many event sources
+        *(volatile char*)(0) = 'E';
+#endif
+        return;
+    }
+
+    Event& event = m_events[m_eventCount];
+    event.m_cycleCount = cycleCount;
+    event.m_order = m_order++;
+    event.m_pHandler = pHandler;
+    event.m_eventID = eventID;
+
+    SiftUp(m_eventCount++);
+}
+
+void SystemEventQueue::Cancel(SystemEventHandler* pHandler, uint32_t eventID)
+{
+    for(uint32_t index = 0;index < m_eventCount;++index)
+    {
+        if(m_events[index].m_pHandler == pHandler && m_events[index].m_eventID == eventID)
+        {
+            Remove(index);
+            return;
+        }
+    }
+}
+
+void SystemEventQueue::Dispatch(uint64_t cycleCount)
+{
+    while(m_eventCount > 0 && m_events[0].m_cycleCount <= cycleCount)
+    {
+        // Pop before calling so the handler can reschedule the same event
+        Event event = m_events[0];
+        Remove(0);
+
+        event.m_pHandler->SystemEvent(event.m_eventID, event.m_cycleCount);
+    }
+}
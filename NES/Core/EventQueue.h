@@ -0,0 +1,67 @@
+//
+//  EventQueue.h
+//  NES
+//
+
+#ifndef EventQueue_h
+#define EventQueue_h
+
+#include "CoreDefines.h"
+
+// Anything that wants a callback at a given master cycle
+class SystemEventHandler
+{
+public:
+    // Called just before the master cycle cycleCount is ticked
+    virtual void SystemEvent(uint32_t eventID, uint64_t cycleCount) = 0;
+};
+
+const uint64_t kNoEventCycle = ~uint64_t(0);
+
+// Min-heap of pending events keyed by master cycle - events due on the same cycle fire in the order they were scheduled
+class SystemEventQueue
+{
+public:
+    SystemEventQueue();
+
+    void Clear();
+
+    // Replaces any pending event with the same handler and ID
+    void Schedule(SystemEventHandler* pHandler, uint32_t eventID, uint64_t cycleCount);
+    void Cancel(SystemEventHandler* pHandler, uint32_t eventID);
+
+    // Fire everything due at or before cycleCount - handlers are free to schedule more
+    void Dispatch(uint64_t cycleCount);
+
+    uint64_t NextEventCycle() const
+    {
+        return m_eventCount > 0 ? m_events[0].m_cycleCount : kNoEventCycle;
+    }
+
+private:
+
+    struct Event
+    {
+        uint64_t m_cycleCount;
+        uint64_t m_order;
+        SystemEventHandler* m_pHandler;
+        uint32_t m_eventID;
+    };
+
+    static bool Before(const Event& a, const Event& b);
+
+    void SiftUp(uint32_t index);
+    void SiftDown(uint32_t index);
+    void Remove(uint32_t index);
+
+private:
+
+    // A handful of sources at most - one pending event per handler and ID
+    static const uint32_t kMaxEvents = 16;
+
+    Event       m_events[kMaxEvents];
+    uint32_t    m_eventCount;
+    uint64_t    m_order;
+};
+
+#endif /* EventQueue_h */
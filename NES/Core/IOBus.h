@@ -10,6 +10,15 @@
 
 #include "CoreDefines.h"
 
+class SystemEventHandler;
+
+// Mappers that react to pattern table fetches (e.g. MMC2 latches, MMC3 A12 counter) - called after each mapped read
+class PPUBusObserver
+{
+public:
+    virtual void PPUBusRead(uint16_t address) = 0;
+};
+
 // Common bus functions
 class IOBus
 {
@@ -22,7 +31,14 @@ public:
     
     // Not everything needs or uses these, but they are available on the bus
     virtual float   AudioOut()                      { return 0.f; }
+    virtual bool    HasAudioOut()                   { return false; }   // AudioOut can change without a CPU write - it has its own timers
     virtual void    SystemTick(uint64_t cycleCount) {}
+    
+    // CPU pages (address >> 8) of plain memory - accesses have no side effects and don't depend on the cycle they happen on
+    virtual bool    cpuPlainMemoryPage(uint8_t page, bool bWrite) { return false; }
+    
+    // Status registers - reading again changes nothing, so a loop can poll one until what it reports changes
+    virtual bool    cpuStatusRegister(uint16_t address) { return false; }
 };
 
 #define BUS_HEADER_DECL     virtual uint8_t cpuRead(uint16_t address) override; \
@@ -38,6 +54,27 @@ public:
     virtual void SignalNMI(bool bSignal)        {}
     virtual void SignalIRQ(bool bSignal)        {}
     virtual void SetMirrorMode(MirrorMode mode) {}
+    
+    // Master cycle the PPU is currently processing - can lag the CPU in catch-up scheduling
+    virtual uint64_t GetPPUCycleCount()         { return 0; }
+    
+    // Master cycle currently being processed
+    virtual uint64_t GetCycleCount()            { return 0; }
+    
+    // Call pHandler back just before the given master cycle ticks - replaces any pending event with the same ID
+    virtual void ScheduleEvent(SystemEventHandler* pHandler, uint32_t eventID, uint64_t cycleCount) {}
+    virtual void CancelEvent(SystemEventHandler* pHandler, uint32_t eventID) {}
+    
+    // Serve CPU reads/writes of whole pages in [address, address + size) straight from pMemory - nullptr goes back to cpuRead/cpuWrite
+    virtual void MapCPURead(uint16_t address, uint32_t size, uint8_t* pMemory)  {}
+    virtual void MapCPUWrite(uint16_t address, uint32_t size, uint8_t* pMemory) {}
+    
+    // Serve PPU pattern table reads of whole 1KB pages in [address, address + size) straight from pMemory - nullptr goes back to ppuRead
+    virtual void MapPPURead(uint16_t address, uint32_t size, uint8_t* pMemory) {}
+    virtual void SetPPUBusObserver(PPUBusObserver* pObserver)                   {}
+    
+    // 4KB of cart nametable RAM for VRAM_MIRROR_CART4 - read and written directly by the PPU
+    virtual void SetCartVRAM(uint8_t* pCartVRAM)                                {}
 };
 
 #endif /* IOBus_h */
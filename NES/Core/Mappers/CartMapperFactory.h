@@ -39,6 +39,15 @@ public:
         
     uint16_t GetMapperID() const     { return m_mapperID; }
     
+    // Mapper can currently raise an IRQ from PPU bus activity (e.g. MMC3 A12 counter)
+    virtual bool PPUBusSignalsIRQ() const { return false; }
+    
+    // Mapper can currently raise an IRQ from SystemTick rather than an event (e.g. VRC6 cycle mode counter)
+    virtual bool TickSignalsIRQ() const { return false; }
+    
+    // Queue any timed events (e.g. IRQ counters) from current state - after power on or load
+    virtual void ScheduleEvents() {}
+    
     // Return larger of the two
     uint32_t GetPrgRamSize() const   { return m_nPrgRamSize > m_nNVPrgRamSize ? m_nPrgRamSize : m_nNVPrgRamSize; }
     
@@ -13,6 +13,28 @@ void CartMapper_0::Initialise()
     {
         m_pChr = m_pCartCHRRAM;
     }
+    
+    // Fixed memory map - 16KB PRG is mirrored
+    if(m_pPrg != nullptr && m_nProgramSize > 0)
+    {
+        m_bus.MapCPURead(0x8000, 0x4000, &m_pPrg[0x0000 & (m_nProgramSize - 1)]);
+        m_bus.MapCPURead(0xC000, 0x4000, &m_pPrg[0x4000 & (m_nProgramSize - 1)]);
+    }
+    if(m_pCartPRGRAM != nullptr)
+    {
+        m_bus.MapCPURead(0x6000, 0x2000, m_pCartPRGRAM);
+        m_bus.MapCPUWrite(0x6000, 0x2000, m_pCartPRGRAM);
+    }
+    
+    // Smaller CHR is mirrored
+    uint32_t addressRange = m_nCharacterSize > 0 ? m_nCharacterSize - 1 : GetChrRamSize() - 1;
+    if(m_pChr != nullptr && addressRange >= 0x3FF)
+    {
+        for(uint32_t page = 0x0000;page < 0x2000;page += 0x400)
+        {
+            m_bus.MapPPURead(page, 0x400, &m_pChr[page & addressRange]);
+        }
+    }
 }
 
 uint8_t CartMapper_0::cpuRead(uint16_t address)
@@ -24,6 +24,9 @@ void CartMapper_1::Initialise()
         m_pChr = m_pCartCHRRAM;
     }
     
+    MapCPUMemory();
+    MapPPUMemory();
+    
 #if DEBUG
     // More than 8KB PRG [NV]RAM is not currently supported - not yet bank switched
     if(GetPrgRamSize() > 8192)
@@ -41,6 +44,8 @@ void CartMapper_1::Load(Archive& rArchive)
     rArchive >> m_chrBank0;
     rArchive >> m_chrBank1;
     rArchive >> m_prgBank;
+    MapCPUMemory();
+    MapPPUMemory();
 }
 
 void CartMapper_1::Save(Archive& rArchive) const
@@ -174,7 +179,62 @@ void CartMapper_1::cpuWrite(uint16_t address, uint8_t byte)
                 
                 m_shiftCount = 0;
                 m_shiftRegister = 0;
+                
+                MapCPUMemory();
+                MapPPUMemory();
+            }
+        }
+    }
+}
+
+void CartMapper_1::MapCPUMemory()
+{
+    if(m_pCartPRGRAM != nullptr)
+    {
+        m_bus.MapCPURead(0x6000, 0x2000, m_pCartPRGRAM);
+        m_bus.MapCPUWrite(0x6000, 0x2000, m_pCartPRGRAM);
+    }
+    
+    uint8_t progBankMode = (m_ctrl >> 2) & 0b11;
+    uint32_t prgBank = m_prgBank & 0b01111;
+    
+    if(progBankMode == 0 || progBankMode == 1)
+    {
+        m_bus.MapCPURead(0x8000, 0x8000, &m_pPrg[(prgBank >> 1) * 0x8000]);
+    }
+    else if(progBankMode == 2)
+    {
+        m_bus.MapCPURead(0x8000, 0x4000, &m_pPrg[0]);
+        m_bus.MapCPURead(0xC000, 0x4000, &m_pPrg[prgBank * 0x4000]);
+    }
+    else if(progBankMode == 3)
+    {
+        m_bus.MapCPURead(0x8000, 0x4000, &m_pPrg[prgBank * 0x4000]);
+        m_bus.MapCPURead(0xC000, 0x4000, &m_pPrg[m_nProgramSize - 0x4000]);
+    }
+}
+
+void CartMapper_1::MapPPUMemory()
+{
+    uint8_t chrBankMode = (m_ctrl >> 4) & 1;
+    uint32_t addressRange = m_nCharacterSize > 0 ? m_nCharacterSize - 1 : GetChrRamSize() - 1;
+    
+    if(m_pChr != nullptr && addressRange >= 0x3FF)
+    {
+        for(uint32_t page = 0x0000;page < 0x2000;page += 0x400)
+        {
+            uint32_t bankAddress = 0;
+            if(chrBankMode == 1)
+            {
+                // 2x 4k banks
+                bankAddress = page < 0x1000 ? (uint32_t(m_chrBank0) * 0x1000) + page : (uint32_t(m_chrBank1) * 0x1000) + (page - 0x1000);
+            }
+            else
+            {
+                // 1x 8k chunk
+                bankAddress = ((uint32_t(m_chrBank0) >> 1) * 0x2000) + page;
             }
+            m_bus.MapPPURead(page, 0x400, &m_pChr[bankAddress & addressRange]);
         }
     }
 }
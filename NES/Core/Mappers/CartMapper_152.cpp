@@ -11,12 +11,16 @@ void CartMapper_152::Initialise()
 {
     m_prgBank = 0;
     m_chrBank = 0;
+    MapCPUMemory();
+    MapPPUMemory();
 }
 
 void CartMapper_152::Load(Archive& rArchive)
 {
     rArchive >> m_prgBank;
     rArchive >> m_chrBank;
+    MapCPUMemory();
+    MapPPUMemory();
 }
 
 void CartMapper_152::Save(Archive& rArchive) const
@@ -45,6 +49,8 @@ void CartMapper_152::cpuWrite(uint16_t address, uint8_t byte)
     {
         m_prgBank = ((byte >> 4) & 0b111) & ((m_nProgramSize / 16384) - 1);
         m_chrBank = ((byte >> 0) & 0b1111) & ((m_nCharacterSize / 8192) - 1);
+        MapCPUMemory();
+        MapPPUMemory();
         
         uint8_t mirror = (byte >> 7) & 0b1;
         if(mirror == 0)
@@ -58,6 +64,21 @@ void CartMapper_152::cpuWrite(uint16_t address, uint8_t byte)
     }
 }
 
+void CartMapper_152::MapCPUMemory()
+{
+    const uint32_t bankSize = 16384;
+    m_bus.MapCPURead(0x8000, bankSize, &m_pPrg[uint32_t(m_prgBank) * bankSize]);
+    m_bus.MapCPURead(0xC000, bankSize, &m_pPrg[m_nProgramSize - bankSize]);
+}
+
+void CartMapper_152::MapPPUMemory()
+{
+    if(m_pChr != nullptr && m_nCharacterSize > 0)
+    {
+        m_bus.MapPPURead(0x0000, 0x2000, &m_pChr[uint32_t(m_chrBank) * 8192]);
+    }
+}
+
 uint8_t CartMapper_152::ppuRead(uint16_t address)
 {
     return m_pChr[(uint32_t(m_chrBank) * 8192) + address];
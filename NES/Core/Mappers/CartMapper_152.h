@@ -16,6 +16,11 @@ public:
     BUS_HEADER_DECL
     MAPPER_HEADER_DECL
     SERIALISABLE_DECL
+private:
+
+    void MapCPUMemory();
+    void MapPPUMemory();
+    
 private:
 
     uint8_t m_prgBank;
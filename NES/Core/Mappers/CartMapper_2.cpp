@@ -10,11 +10,22 @@
 void CartMapper_2::Initialise()
 {
     m_prgBankSelect = 0;
+    MapCPUMemory();
+    
+    // Fixed CHR RAM
+    if(m_pCartCHRRAM != nullptr && m_nChrRamSize >= 0x400)
+    {
+        for(uint32_t page = 0x0000;page < 0x2000;page += 0x400)
+        {
+            m_bus.MapPPURead(page, 0x400, &m_pCartCHRRAM[page % m_nChrRamSize]);
+        }
+    }
 }
 
 void CartMapper_2::Load(Archive& rArchive)
 {
     rArchive >> m_prgBankSelect;
+    MapCPUMemory();
 }
 
 void CartMapper_2::Save(Archive& rArchive) const
@@ -48,6 +59,16 @@ void CartMapper_2::cpuWrite(uint16_t address, uint8_t byte)
     {
         uint16_t maxBanks = (m_nProgramSize / 0x4000);
         m_prgBankSelect = byte & (maxBanks - 1);
+        MapCPUMemory();
+    }
+}
+
+void CartMapper_2::MapCPUMemory()
+{
+    if(m_pPrg != nullptr && m_nProgramSize > 0)
+    {
+        m_bus.MapCPURead(0x8000, 0x4000, &m_pPrg[uint32_t(m_prgBankSelect) * 0x4000]);
+        m_bus.MapCPURead(0xC000, 0x4000, &m_pPrg[m_nProgramSize - 0x4000]);
     }
 }
 
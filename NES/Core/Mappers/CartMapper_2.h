@@ -17,6 +17,11 @@ public:
     MAPPER_HEADER_DECL
     SERIALISABLE_DECL
 private:
+
+    void MapCPUMemory();
+    
+private:
+
     uint8_t m_prgBankSelect;
 };
 
@@ -12,6 +12,7 @@ void CartMapper_23::Initialise()
     m_prgBank0 = &m_pPrg[0];
     m_prgBank1 = &m_pPrg[m_nProgramSize - 0x6000];
     m_prgBank2 = &m_pPrg[m_nProgramSize - 0x4000];
+    MapCPUMemory();
     
     if(m_nCharacterSize == 0)
     {
@@ -26,6 +27,7 @@ void CartMapper_23::Initialise()
     m_chrBank5 = &m_pChr[0x0400 * 5];
     m_chrBank6 = &m_pChr[0x0400 * 6];
     m_chrBank7 = &m_pChr[0x0400 * 7];
+    MapPPUMemory();
     
     m_microWireLatch = 0;
     m_regChrBank0 = 0;
@@ -62,6 +64,7 @@ void CartMapper_23::Load(Archive& rArchive)
         m_prgBank0 = pBasePrgAddress + offsetBank0;
         m_prgBank1 = pBasePrgAddress + offsetBank1;
         m_prgBank2 = pBasePrgAddress + offsetBank2;
+        MapCPUMemory();
     }
 
     {
@@ -90,6 +93,7 @@ void CartMapper_23::Load(Archive& rArchive)
         m_chrBank5 = pBaseChrAddress + offsetBank5;
         m_chrBank6 = pBaseChrAddress + offsetBank6;
         m_chrBank7 = pBaseChrAddress + offsetBank7;
+        MapPPUMemory();
     }
 }
 
@@ -177,12 +181,14 @@ void CartMapper_23::cpuWrite(uint16_t address, uint8_t byte)
         uint32_t bankIndex = (byte & 0b11111) & ((m_nProgramSize / 8192) - 1);
         uint32_t bankAddress = bankIndex * 8192;
         m_prgBank0 = &m_pPrg[bankAddress];
+        MapCPUMemory();
     }
     else if(regAddress >= 0xA000 && regAddress <= 0xA003)
     {
         uint32_t bankIndex = (byte & 0b11111) & ((m_nProgramSize / 8192) - 1);
         uint32_t bankAddress = bankIndex * 8192;
         m_prgBank1 = &m_pPrg[bankAddress];
+        MapCPUMemory();
     }
     else if(regAddress >= 0x9000 && regAddress <= 0x9003)
     {
@@ -278,12 +284,33 @@ void CartMapper_23::cpuWrite(uint16_t address, uint8_t byte)
     }
 }
 
+void CartMapper_23::MapCPUMemory()
+{
+    // $6000-$7FFF is the microwire latch, not RAM
+    m_bus.MapCPURead(0x8000, 0x2000, m_prgBank0);
+    m_bus.MapCPURead(0xA000, 0x2000, m_prgBank1);
+    m_bus.MapCPURead(0xC000, 0x4000, m_prgBank2);
+}
+
 void CartMapper_23::SetChrBank(uint8_t** pChrBank, uint8_t bank)
 {
     uint32_t maxBanks = (m_nCharacterSize > 0 ? m_nCharacterSize : GetChrRamSize()) / 0x400;
     uint32_t bankIndex = uint32_t(bank) & (maxBanks - 1);
     uint32_t bankAddress = bankIndex * 0x400;
     *pChrBank = &m_pChr[bankAddress];
+    MapPPUMemory();
+}
+
+void CartMapper_23::MapPPUMemory()
+{
+    m_bus.MapPPURead(0x0000, 0x0400, m_chrBank0);
+    m_bus.MapPPURead(0x0400, 0x0400, m_chrBank1);
+    m_bus.MapPPURead(0x0800, 0x0400, m_chrBank2);
+    m_bus.MapPPURead(0x0C00, 0x0400, m_chrBank3);
+    m_bus.MapPPURead(0x1000, 0x0400, m_chrBank4);
+    m_bus.MapPPURead(0x1400, 0x0400, m_chrBank5);
+    m_bus.MapPPURead(0x1800, 0x0400, m_chrBank6);
+    m_bus.MapPPURead(0x1C00, 0x0400, m_chrBank7);
 }
 
 uint8_t CartMapper_23::ppuRead(uint16_t address)
@@ -20,6 +20,8 @@ public:
 private:
 
     void SetChrBank(uint8_t** pChrBank, uint8_t bank);
+    void MapCPUMemory();
+    void MapPPUMemory();
         
 private:
 
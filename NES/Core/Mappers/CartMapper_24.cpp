@@ -12,6 +12,7 @@ void CartMapper_24::Initialise()
     m_prgBank0 = &m_pPrg[0];
     m_prgBank1 = &m_pPrg[m_nProgramSize - 0x4000];
     m_prgBank2 = &m_pPrg[m_nProgramSize - 0x2000];
+    MapCPUMemory();
     
     if(m_nCharacterSize == 0)
     {
@@ -26,6 +27,7 @@ void CartMapper_24::Initialise()
     m_chrBank5 = &m_pChr[0x0400 * 5];
     m_chrBank6 = &m_pChr[0x0400 * 6];
     m_chrBank7 = &m_pChr[0x0400 * 7];
+    MapPPUMemory();
     
     m_irqLatch = 0;
     m_irqMode = 0;
@@ -33,6 +35,7 @@ void CartMapper_24::Initialise()
     m_irqEnableAfterAck = 0;
     m_irqCounter = 0;
     m_irqPrescaler = 0;
+    m_irqPrescalerCycle = 0;
 }
 
 void CartMapper_24::Load(Archive& rArchive)
@@ -59,6 +62,7 @@ void CartMapper_24::Load(Archive& rArchive)
         m_prgBank0 = pBasePrgAddress + offsetBank0;
         m_prgBank1 = pBasePrgAddress + offsetBank1;
         m_prgBank2 = pBasePrgAddress + offsetBank2;
+        MapCPUMemory();
     }
 
     {
@@ -87,6 +91,7 @@ void CartMapper_24::Load(Archive& rArchive)
         m_chrBank5 = pBaseChrAddress + offsetBank5;
         m_chrBank6 = pBaseChrAddress + offsetBank6;
         m_chrBank7 = pBaseChrAddress + offsetBank7;
+        MapPPUMemory();
     }
 }
 
@@ -97,7 +102,7 @@ void CartMapper_24::Save(Archive& rArchive) const
     rArchive << m_irqEnable;
     rArchive << m_irqEnableAfterAck;
     rArchive << m_irqCounter;
-    rArchive << m_irqPrescaler;
+    rArchive << GetIRQPrescaler();
     
     rArchive << m_pulse1;
     rArchive << m_pulse2;
@@ -172,6 +177,7 @@ void CartMapper_24::cpuWrite(uint16_t address, uint8_t byte)
         uint32_t max16kBanks = m_nProgramSize / 0x4000;
         uint32_t bank = (byte & 0b00001111) & (max16kBanks - 1);
         m_prgBank0 = &m_pPrg[bank * 0x4000];
+        MapCPUMemory();
     }
     else if(registerAddress >= 0xC000 && registerAddress <= 0xC003)
     {
@@ -179,6 +185,7 @@ void CartMapper_24::cpuWrite(uint16_t address, uint8_t byte)
         uint32_t max8kBanks = m_nProgramSize / 0x2000;
         uint32_t bank = (byte & 0b00011111) & (max8kBanks - 1);
         m_prgBank1 = &m_pPrg[bank * 0x2000];
+        MapCPUMemory();
     }
     else if(registerAddress == 0xB003)
     {
@@ -268,11 +275,17 @@ void CartMapper_24::cpuWrite(uint16_t address, uint8_t byte)
         {
             m_irqCounter = m_irqLatch;
         }
+        
+        ScheduleIRQPrescaler();
     }
     else if(registerAddress == 0xF002)
     {
         m_bus.SignalIRQ(false);
+        
+        m_irqPrescaler = GetIRQPrescaler();
         m_irqEnable = m_irqEnableAfterAck;
+        
+        ScheduleIRQPrescaler();
     }
     else if(registerAddress >= 0x9000 && registerAddress <= 0x9002)
     {
@@ -298,6 +311,45 @@ void CartMapper_24::cpuWrite(uint16_t address, uint8_t byte)
     }
 }
 
+uint16_t CartMapper_24::GetIRQPrescaler() const
+{
+    if(m_irqMode == 0 && m_irqEnable)
+    {
+        return uint16_t(m_irqPrescalerCycle - m_bus.GetCycleCount());
+    }
+    return m_irqPrescaler;
+}
+
+void CartMapper_24::ScheduleIRQPrescaler()
+{
+    // Scanline mode prescaler counts down every master cycle while enabled
+    if(m_irqMode == 0 && m_irqEnable)
+    {
+        const uint32_t cycles = m_irqPrescaler > 0 ? m_irqPrescaler : 0x10000;
+        m_irqPrescalerCycle = m_bus.GetCycleCount() + cycles;
+        m_bus.ScheduleEvent(this, VRC6_EVENT_IRQ_PRESCALER, m_irqPrescalerCycle);
+    }
+    else
+    {
+        m_bus.CancelEvent(this, VRC6_EVENT_IRQ_PRESCALER);
+    }
+}
+
+void CartMapper_24::ScheduleEvents()
+{
+    ScheduleIRQPrescaler();
+}
+
+void CartMapper_24::SystemEvent(uint32_t eventID, uint64_t cycleCount)
+{
+    // Prescaler reached 0
+    m_irqPrescaler = 341;
+    ClockIRQCounter();
+    
+    m_irqPrescalerCycle = cycleCount + m_irqPrescaler;
+    m_bus.ScheduleEvent(this, VRC6_EVENT_IRQ_PRESCALER, m_irqPrescalerCycle);
+}
+
 void CartMapper_24::ClockIRQCounter()
 {
     if(m_irqEnable)
@@ -326,24 +378,18 @@ void CartMapper_24::SystemTick(uint64_t cycleCount)
         m_saw.Tick();
     }
     
-    if(m_irqMode == 1)
+    // Scanline mode is clocked by the prescaler event
+    if(m_irqMode == 1 && bCPUTick)
     {
-        if(bCPUTick)
-        {
-            ClockIRQCounter();
-        }
-    }
-    else if(m_irqEnable)
-    {
-        --m_irqPrescaler;
-        if(m_irqPrescaler == 0)
-        {
-            m_irqPrescaler = 341;
-            ClockIRQCounter();
-        }
+        ClockIRQCounter();
     }
 }
 
+bool CartMapper_24::TickSignalsIRQ() const
+{
+    return m_irqMode == 1 && m_irqEnable != 0;
+}
+
 float CartMapper_24::AudioOut()
 {
     float pulse1 = m_pulse1.OutputValue();
@@ -356,12 +402,42 @@ float CartMapper_24::AudioOut()
     return fPulse + fSaw;
 }
 
+bool CartMapper_24::HasAudioOut()
+{
+    return true;
+}
+
+void CartMapper_24::MapCPUMemory()
+{
+    if(m_pCartPRGRAM != nullptr)
+    {
+        m_bus.MapCPURead(0x6000, 0x2000, m_pCartPRGRAM);
+        m_bus.MapCPUWrite(0x6000, 0x2000, m_pCartPRGRAM);
+    }
+    m_bus.MapCPURead(0x8000, 0x4000, m_prgBank0);
+    m_bus.MapCPURead(0xC000, 0x2000, m_prgBank1);
+    m_bus.MapCPURead(0xE000, 0x2000, m_prgBank2);
+}
+
 void CartMapper_24::SetChrBank(uint8_t** pChrBank, uint8_t bank)
 {
     uint32_t maxBanks = (m_nCharacterSize > 0 ? m_nCharacterSize : GetChrRamSize()) / 0x400;
     uint32_t bankIndex = uint32_t(bank) & (maxBanks - 1);
     uint32_t bankAddress = bankIndex * 0x400;
     *pChrBank = &m_pChr[bankAddress];
+    MapPPUMemory();
+}
+
+void CartMapper_24::MapPPUMemory()
+{
+    m_bus.MapPPURead(0x0000, 0x0400, m_chrBank0);
+    m_bus.MapPPURead(0x0400, 0x0400, m_chrBank1);
+    m_bus.MapPPURead(0x0800, 0x0400, m_chrBank2);
+    m_bus.MapPPURead(0x0C00, 0x0400, m_chrBank3);
+    m_bus.MapPPURead(0x1000, 0x0400, m_chrBank4);
+    m_bus.MapPPURead(0x1400, 0x0400, m_chrBank5);
+    m_bus.MapPPURead(0x1800, 0x0400, m_chrBank6);
+    m_bus.MapPPURead(0x1C00, 0x0400, m_chrBank7);
 }
 
 uint8_t CartMapper_24::ppuRead(uint16_t address)
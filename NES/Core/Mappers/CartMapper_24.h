@@ -9,6 +9,7 @@
 #define CartMapper_24_h
 
 #include "CartMapperFactory.h"
+#include "EventQueue.h"
 
 class VRC6AudioPulseChannel : public Serialisable
 {
@@ -53,7 +54,7 @@ private:
     uint8_t m_accumulator;
 };
 
-class CartMapper_24 : public Mapper
+class CartMapper_24 : public Mapper, public SystemEventHandler
 {
 public:
     BUS_HEADER_DECL
@@ -61,12 +62,25 @@ public:
     SERIALISABLE_DECL
     
     virtual float AudioOut() override;
+    virtual bool HasAudioOut() override;
     virtual void SystemTick(uint64_t cycleCount) override;
+    virtual bool TickSignalsIRQ() const override;
+    virtual void ScheduleEvents() override;
+    virtual void SystemEvent(uint32_t eventID, uint64_t cycleCount) override;
     
 private:
 
+    enum VRC6_EVENT : uint32_t
+    {
+        VRC6_EVENT_IRQ_PRESCALER = 0
+    };
+
+    uint16_t GetIRQPrescaler() const;
+    void ScheduleIRQPrescaler();
     void ClockIRQCounter();
     void SetChrBank(uint8_t** pChrBank, uint8_t bank);
+    void MapCPUMemory();
+    void MapPPUMemory();
     
 private:
 
@@ -90,6 +104,7 @@ private:
     uint8_t m_irqEnableAfterAck;
     uint8_t m_irqCounter;
     uint16_t m_irqPrescaler;
+    uint64_t m_irqPrescalerCycle;       // Master cycle the prescaler next reaches 0 while counting scanlines - m_irqPrescaler is stale then
     
     VRC6AudioPulseChannel   m_pulse1;
     VRC6AudioPulseChannel   m_pulse2;
@@ -10,11 +10,20 @@
 void CartMapper_3::Initialise()
 {
     m_chrBankSelect = 0;
+    MapPPUMemory();
+    
+    // Fixed memory map - 16KB PRG is mirrored
+    if(m_pPrg != nullptr && m_nProgramSize > 0)
+    {
+        m_bus.MapCPURead(0x8000, 0x4000, &m_pPrg[0x0000 & (m_nProgramSize - 1)]);
+        m_bus.MapCPURead(0xC000, 0x4000, &m_pPrg[0x4000 & (m_nProgramSize - 1)]);
+    }
 }
 
 void CartMapper_3::Load(Archive& rArchive)
 {
     rArchive >> m_chrBankSelect;
+    MapPPUMemory();
 }
 
 void CartMapper_3::Save(Archive& rArchive) const
@@ -42,6 +51,15 @@ void CartMapper_3::cpuWrite(uint16_t address, uint8_t byte)
         // compute max number of chr rom bits this cart can handle in 8k chunkcs
         uint32_t maxSize = (m_nCharacterSize / 8192) - 1;
         m_chrBankSelect = (byte & 0b11) & maxSize;
+        MapPPUMemory();
+    }
+}
+
+void CartMapper_3::MapPPUMemory()
+{
+    if(m_pChr != nullptr && m_nCharacterSize > 0)
+    {
+        m_bus.MapPPURead(0x0000, 0x2000, &m_pChr[m_chrBankSelect * 8192]);
     }
 }
 
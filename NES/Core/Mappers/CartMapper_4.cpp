@@ -24,6 +24,7 @@ void CartMapper_4::Initialise()
     m_prgBank1 = &m_pPrg[m_nProgramSize - 0x4000];
     m_prgBank2 = &m_pPrg[m_nProgramSize - 0x4000];
     m_prgBank3 = &m_pPrg[m_nProgramSize - 0x2000];
+    MapCPUMemory();
     
     if(m_nCharacterSize == 0)
     {
@@ -38,6 +39,13 @@ void CartMapper_4::Initialise()
     m_chrBank5 = &m_pChr[0x0400 * 5];
     m_chrBank6 = &m_pChr[0x0400 * 6];
     m_chrBank7 = &m_pChr[0x0400 * 7];
+    MapPPUMemory();
+    
+    // MMC3 scanline counter watches A12 on pattern fetches
+    if(m_mapperID == 4)
+    {
+        m_bus.SetPPUBusObserver(this);
+    }
     
     // There is a bug in the IRQ handling
     // Provide a per game workaround
@@ -81,6 +89,7 @@ void CartMapper_4::Load(Archive& rArchive)
         m_prgBank1 = pBasePrgAddress + offsetBank1;
         m_prgBank2 = pBasePrgAddress + offsetBank2;
         m_prgBank3 = pBasePrgAddress + offsetBank3;
+        MapCPUMemory();
     }
 
     {
@@ -109,6 +118,7 @@ void CartMapper_4::Load(Archive& rArchive)
         m_chrBank5 = pBaseChrAddress + offsetBank5;
         m_chrBank6 = pBaseChrAddress + offsetBank6;
         m_chrBank7 = pBaseChrAddress + offsetBank7;
+        MapPPUMemory();
     }
         
     rArchive >> m_scanlineLatch;
@@ -297,6 +307,7 @@ void CartMapper_4::cpuWrite(uint16_t address, uint8_t byte)
                         m_chrBank3 = &m_pChr[bankData * chrBankSize];
                     }
                 }
+                MapPPUMemory();
             }
             else if(registerSelect >= 6 && registerSelect <= 7)
             {
@@ -338,6 +349,7 @@ void CartMapper_4::cpuWrite(uint16_t address, uint8_t byte)
                     }
                     m_prgBank3 = &m_pPrg[m_nProgramSize - (prgBankSize * 1)];
                 }
+                MapCPUMemory();
             }
         }
     }
@@ -387,6 +399,19 @@ void CartMapper_4::cpuWrite(uint16_t address, uint8_t byte)
     }
 }
 
+void CartMapper_4::MapCPUMemory()
+{
+    if(m_pCartPRGRAM != nullptr)
+    {
+        m_bus.MapCPURead(0x6000, 0x2000, m_pCartPRGRAM);
+        m_bus.MapCPUWrite(0x6000, 0x2000, m_pCartPRGRAM);
+    }
+    m_bus.MapCPURead(0x8000, 0x2000, m_prgBank0);
+    m_bus.MapCPURead(0xA000, 0x2000, m_prgBank1);
+    m_bus.MapCPURead(0xC000, 0x2000, m_prgBank2);
+    m_bus.MapCPURead(0xE000, 0x2000, m_prgBank3);
+}
+
 uint8_t CartMapper_4::ppuRead(uint16_t address)
 {
     MM3Signal(address);
@@ -464,15 +489,35 @@ void CartMapper_4::ppuWrite(uint16_t address, uint8_t byte)
     }
 }
 
-void CartMapper_4::SystemTick(uint64_t cycleCount)
+void CartMapper_4::MapPPUMemory()
 {
-    m_systemCycleCount = cycleCount;
+    m_bus.MapPPURead(0x0000, 0x0400, m_chrBank0);
+    m_bus.MapPPURead(0x0400, 0x0400, m_chrBank1);
+    m_bus.MapPPURead(0x0800, 0x0400, m_chrBank2);
+    m_bus.MapPPURead(0x0C00, 0x0400, m_chrBank3);
+    m_bus.MapPPURead(0x1000, 0x0400, m_chrBank4);
+    m_bus.MapPPURead(0x1400, 0x0400, m_chrBank5);
+    m_bus.MapPPURead(0x1800, 0x0400, m_chrBank6);
+    m_bus.MapPPURead(0x1C00, 0x0400, m_chrBank7);
+}
+
+void CartMapper_4::PPUBusRead(uint16_t address)
+{
+    MM3Signal(address);
+}
+
+bool CartMapper_4::PPUBusSignalsIRQ() const
+{
+    return m_mapperID == 4 && m_scanlineEnable != 0;
 }
 
 void CartMapper_4::MM3Signal(uint16_t address)
 {
     if(m_mapperID == 4)
     {
+        // Time of this PPU access
+        m_systemCycleCount = m_bus.GetPPUCycleCount();
+        
         uint8_t currentA12 = (address & (1 << 12)) >> 12;
         
         // We need to know how many cycles have passes since A12 went low
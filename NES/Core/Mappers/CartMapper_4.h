@@ -10,17 +10,20 @@
 
 #include "CartMapperFactory.h"
 
-class CartMapper_4 : public Mapper
+class CartMapper_4 : public Mapper, public PPUBusObserver
 {
 public:
     BUS_HEADER_DECL
     MAPPER_HEADER_DECL
     SERIALISABLE_DECL
     
-    virtual void SystemTick(uint64_t cycleCount) override;
+    virtual bool PPUBusSignalsIRQ() const override;
+    virtual void PPUBusRead(uint16_t address) override;
     
 private:
     void MM3Signal(uint16_t address);
+    void MapCPUMemory();
+    void MapPPUMemory();
     
 private:
 
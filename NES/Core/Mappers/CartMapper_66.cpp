@@ -10,11 +10,15 @@
 void CartMapper_66::Initialise()
 {
     m_bankSelect = 0;
+    MapCPUMemory();
+    MapPPUMemory();
 }
 
 void CartMapper_66::Load(Archive& rArchive)
 {
     rArchive >> m_bankSelect;
+    MapCPUMemory();
+    MapPPUMemory();
 }
 
 void CartMapper_66::Save(Archive& rArchive) const
@@ -39,6 +43,23 @@ void CartMapper_66::cpuWrite(uint16_t address, uint8_t byte)
     if(address >= 0x8000 && address <= 0xFFFF)
     {
         m_bankSelect = byte;
+        MapCPUMemory();
+        MapPPUMemory();
+    }
+}
+
+void CartMapper_66::MapCPUMemory()
+{
+    uint32_t prgBank = (m_bankSelect >> 4) & 0b11;
+    m_bus.MapCPURead(0x8000, 0x8000, &m_pPrg[prgBank * 32768]);
+}
+
+void CartMapper_66::MapPPUMemory()
+{
+    if(m_pChr != nullptr && m_nCharacterSize > 0)
+    {
+        uint32_t chrBank = m_bankSelect & 0b11;
+        m_bus.MapPPURead(0x0000, 0x2000, &m_pChr[chrBank * 8192]);
     }
 }
 
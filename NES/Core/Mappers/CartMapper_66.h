@@ -17,6 +17,12 @@ public:
     MAPPER_HEADER_DECL
     SERIALISABLE_DECL
 private:
+
+    void MapCPUMemory();
+    void MapPPUMemory();
+    
+private:
+
     uint8_t m_bankSelect;
 };
 
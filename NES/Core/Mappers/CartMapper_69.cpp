@@ -17,6 +17,7 @@ void CartMapper_69::Initialise()
     m_prgBank2 = &m_pPrg[m_nProgramSize - 0x6000];
     m_prgBank3 = &m_pPrg[m_nProgramSize - 0x4000];
     m_prgBank4 = &m_pPrg[m_nProgramSize - 0x2000];
+    MapCPUMemory();
     
     m_chrBank0 = &m_pChr[0x0400 * 0];
     m_chrBank1 = &m_pChr[0x0400 * 1];
@@ -26,10 +27,12 @@ void CartMapper_69::Initialise()
     m_chrBank5 = &m_pChr[0x0400 * 5];
     m_chrBank6 = &m_pChr[0x0400 * 6];
     m_chrBank7 = &m_pChr[0x0400 * 7];
+    MapPPUMemory();
     
     m_irqGenerate = 0;
     m_irqCounterDecrement = 0;
     m_irqCounter = 0;
+    m_irqCounterCycle = 0;
 }
 
 void CartMapper_69::Load(Archive& rArchive)
@@ -64,6 +67,7 @@ void CartMapper_69::Load(Archive& rArchive)
         {
             m_prgBank0 = m_pCartPRGRAM;
         }
+        MapCPUMemory();
     }
 
     {
@@ -92,6 +96,7 @@ void CartMapper_69::Load(Archive& rArchive)
         m_chrBank5 = pBaseChrAddress + offsetBank5;
         m_chrBank6 = pBaseChrAddress + offsetBank6;
         m_chrBank7 = pBaseChrAddress + offsetBank7;
+        MapPPUMemory();
     }
 }
 
@@ -103,7 +108,7 @@ void CartMapper_69::Save(Archive& rArchive) const
     rArchive << m_prgBank0RAMEnabled;
     rArchive << m_irqGenerate;
     rArchive << m_irqCounterDecrement;
-    rArchive << m_irqCounter;
+    rArchive << GetIRQCounter(m_bus.GetCycleCount());
     
     {
         uint8_t* pBasePrgAddress = &m_pPrg[0];
@@ -222,6 +227,7 @@ void CartMapper_69::cpuWrite(uint16_t address, uint8_t byte)
             {
                 m_chrBank7 = &m_pChr[chrBankSize * bank];
             }
+            MapPPUMemory();
         }
         else if(m_cmdRegister >= 0x8 && m_cmdRegister <= 0xB)
         {
@@ -255,6 +261,7 @@ void CartMapper_69::cpuWrite(uint16_t address, uint8_t byte)
             {
                 m_prgBank3 = &m_pPrg[bank * bankSize];
             }
+            MapCPUMemory();
         }
         else if(m_cmdRegister == 0xC)
         {
@@ -280,6 +287,8 @@ void CartMapper_69::cpuWrite(uint16_t address, uint8_t byte)
         else if(m_cmdRegister >= 0xD && m_cmdRegister <= 0xF)
         {
             // IRQ Control
+            SyncIRQCounter(m_bus.GetCycleCount());
+            
             if(m_cmdRegister == 0xD)
             {
                 m_irqGenerate = byte & 0b1;
@@ -294,6 +303,8 @@ void CartMapper_69::cpuWrite(uint16_t address, uint8_t byte)
             {
                 m_irqCounter = (uint16_t(byte) << 8) | (m_irqCounter & 0x00FF);
             }
+            
+            ScheduleIRQ();
         }
     }
     else if(address >= 0xC000 && address <= 0xDFFF)
@@ -312,19 +323,84 @@ float CartMapper_69::AudioOut()
     return 0.f;
 }
 
-void CartMapper_69::SystemTick(uint64_t cycleCount)
+uint16_t CartMapper_69::GetIRQCounter(uint64_t cycleCount) const
 {
-    if(m_irqCounterDecrement && (cycleCount % 3) == 0)
+    if(m_irqCounterDecrement)
+    {
+        // Decrements on every CPU tick
+        const uint64_t cpuTicks = (cycleCount / 3) - (m_irqCounterCycle / 3);
+        return uint16_t(m_irqCounter - cpuTicks);
+    }
+    return m_irqCounter;
+}
+
+void CartMapper_69::SyncIRQCounter(uint64_t cycleCount)
+{
+    m_irqCounter = GetIRQCounter(cycleCount);
+    m_irqCounterCycle = cycleCount;
+}
+
+void CartMapper_69::ScheduleIRQ()
+{
+    if(m_irqCounterDecrement && m_irqGenerate)
     {
-        --m_irqCounter;
         // Should be 0xFFFF - but hold it back a bit - prob same thing as NMI delay
-        if(m_irqCounter == 0xFFF8 && m_irqGenerate)
+        uint32_t cpuTicks = uint16_t(m_irqCounter - 0xFFF8);
+        if(cpuTicks == 0)
         {
-            m_bus.SignalIRQ(true);
+            cpuTicks = 0x10000;
         }
+        
+        const uint64_t cpuTickCycle = (m_irqCounterCycle / 3 + cpuTicks) * 3;
+        m_bus.ScheduleEvent(this, FME7_EVENT_IRQ, cpuTickCycle);
+    }
+    else
+    {
+        m_bus.CancelEvent(this, FME7_EVENT_IRQ);
     }
 }
 
+void CartMapper_69::ScheduleEvents()
+{
+    // Counter is up to date after power on or load
+    m_irqCounterCycle = m_bus.GetCycleCount();
+    ScheduleIRQ();
+}
+
+void CartMapper_69::SystemEvent(uint32_t eventID, uint64_t cycleCount)
+{
+    // Counter just reached 0xFFF8
+    SyncIRQCounter(cycleCount);
+    m_bus.SignalIRQ(true);
+    
+    ScheduleIRQ();
+}
+
+void CartMapper_69::MapCPUMemory()
+{
+    // $6000-$7FFF is ROM, enabled RAM or open bus
+    bool bRAMEnabled = m_prgBank0RAM && m_prgBank0RAMEnabled && m_pCartPRGRAM == m_prgBank0 && m_prgBank0 != nullptr;
+    m_bus.MapCPURead(0x6000, 0x2000, !m_prgBank0RAM || bRAMEnabled ? m_prgBank0 : nullptr);
+    m_bus.MapCPUWrite(0x6000, 0x2000, bRAMEnabled ? m_prgBank0 : nullptr);
+    
+    m_bus.MapCPURead(0x8000, 0x2000, m_prgBank1);
+    m_bus.MapCPURead(0xA000, 0x2000, m_prgBank2);
+    m_bus.MapCPURead(0xC000, 0x2000, m_prgBank3);
+    m_bus.MapCPURead(0xE000, 0x2000, m_prgBank4);
+}
+
+void CartMapper_69::MapPPUMemory()
+{
+    m_bus.MapPPURead(0x0000, 0x0400, m_chrBank0);
+    m_bus.MapPPURead(0x0400, 0x0400, m_chrBank1);
+    m_bus.MapPPURead(0x0800, 0x0400, m_chrBank2);
+    m_bus.MapPPURead(0x0C00, 0x0400, m_chrBank3);
+    m_bus.MapPPURead(0x1000, 0x0400, m_chrBank4);
+    m_bus.MapPPURead(0x1400, 0x0400, m_chrBank5);
+    m_bus.MapPPURead(0x1800, 0x0400, m_chrBank6);
+    m_bus.MapPPURead(0x1C00, 0x0400, m_chrBank7);
+}
+
 uint8_t CartMapper_69::ppuRead(uint16_t address)
 {
     if(address >= 0x0000 && address <= 0x03FF)
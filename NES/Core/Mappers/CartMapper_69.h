@@ -10,8 +10,9 @@
 #define CartMapper_69_h
 
 #include "CartMapperFactory.h"
+#include "EventQueue.h"
 
-class CartMapper_69 : public Mapper
+class CartMapper_69 : public Mapper, public SystemEventHandler
 {
 public:
     BUS_HEADER_DECL
@@ -19,7 +20,21 @@ public:
     SERIALISABLE_DECL
 
     virtual float AudioOut() override;
-    virtual void SystemTick(uint64_t cycleCount) override;
+    virtual void ScheduleEvents() override;
+    virtual void SystemEvent(uint32_t eventID, uint64_t cycleCount) override;
+    
+private:
+
+    enum FME7_EVENT : uint32_t
+    {
+        FME7_EVENT_IRQ = 0
+    };
+
+    uint16_t GetIRQCounter(uint64_t cycleCount) const;
+    void SyncIRQCounter(uint64_t cycleCount);
+    void ScheduleIRQ();
+    void MapCPUMemory();
+    void MapPPUMemory();
     
 private:
 
@@ -50,6 +65,7 @@ private:
     uint8_t m_irqGenerate;
     uint8_t m_irqCounterDecrement;
     uint16_t m_irqCounter;
+    uint64_t m_irqCounterCycle;         // Master cycle m_irqCounter was last brought up to date
 
 };
 
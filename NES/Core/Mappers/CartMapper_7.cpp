@@ -11,11 +11,22 @@ void CartMapper_7::Initialise()
 {
     uint16_t maxBanks = (m_nProgramSize / 0x8000);
     m_prgBankSelect = maxBanks - 1;
+    MapCPUMemory();
+    
+    // Fixed CHR RAM
+    if(m_pCartCHRRAM != nullptr)
+    {
+        for(uint32_t page = 0x0000;page < 0x2000;page += 0x400)
+        {
+            m_bus.MapPPURead(page, 0x400, &m_pCartCHRRAM[page & (m_nCharacterSize - 1)]);
+        }
+    }
 }
 
 void CartMapper_7::Load(Archive& rArchive)
 {
     rArchive >> m_prgBankSelect;
+    MapCPUMemory();
 }
 
 void CartMapper_7::Save(Archive& rArchive) const
@@ -39,6 +50,7 @@ void CartMapper_7::cpuWrite(uint16_t address, uint8_t byte)
     {
         uint16_t maxBanks = (m_nProgramSize / 0x8000);
         m_prgBankSelect = (byte & 0b111) & maxBanks - 1;
+        MapCPUMemory();
         
         uint8_t nameTableVRAMSelect = (byte >> 4) & 0b1;
         if(nameTableVRAMSelect == 0)
@@ -52,6 +64,11 @@ void CartMapper_7::cpuWrite(uint16_t address, uint8_t byte)
     }
 }
 
+void CartMapper_7::MapCPUMemory()
+{
+    m_bus.MapCPURead(0x8000, 0x8000, &m_pPrg[uint32_t(m_prgBankSelect) * 0x8000]);
+}
+
 uint8_t CartMapper_7::ppuRead(uint16_t address)
 {
     return m_pCartCHRRAM[address & (m_nCharacterSize - 1)];
@@ -16,8 +16,12 @@ public:
     BUS_HEADER_DECL
     MAPPER_HEADER_DECL
     SERIALISABLE_DECL
+private:
 
+    void MapCPUMemory();
+    
 private:
+
     uint8_t m_prgBankSelect;
 };
 
@@ -16,6 +16,11 @@ void CartMapper_9::Initialise()
     m_chrBankSelect3 = 0;
     m_latch0 = 0xFD;
     m_latch1 = 0xFD;
+    MapCPUMemory();
+    MapPPUMemory();
+    
+    // Latches flip on pattern fetches
+    m_bus.SetPPUBusObserver(this);
 }
 
 void CartMapper_9::Load(Archive& rArchive)
@@ -27,6 +32,8 @@ void CartMapper_9::Load(Archive& rArchive)
     rArchive >> m_chrBankSelect3;
     rArchive >> m_latch0;
     rArchive >> m_latch1;
+    MapCPUMemory();
+    MapPPUMemory();
 }
 
 void CartMapper_9::Save(Archive& rArchive) const
@@ -61,22 +68,27 @@ void CartMapper_9::cpuWrite(uint16_t address, uint8_t byte)
     if(address >= 0xA000 && address <= 0xAFFF)
     {
         m_prgBankSelect = byte & 0b1111;
+        MapCPUMemory();
     }
     else if(address >= 0xB000 && address <= 0xBFFF)
     {
         m_chrBankSelect0 = byte & 0b11111;
+        MapPPUMemory();
     }
     else if(address >= 0xC000 && address <= 0xCFFF)
     {
         m_chrBankSelect1 = byte & 0b11111;
+        MapPPUMemory();
     }
     else if(address >= 0xD000 && address <= 0xDFFF)
     {
         m_chrBankSelect2 = byte & 0b11111;
+        MapPPUMemory();
     }
     else if(address >= 0xE000 && address <= 0xEFFF)
     {
         m_chrBankSelect3 = byte & 0b11111;
+        MapPPUMemory();
     }
     else if(address >= 0xF000 && address <= 0xFFFF)
     {
@@ -92,6 +104,40 @@ void CartMapper_9::cpuWrite(uint16_t address, uint8_t byte)
     }
 }
 
+void CartMapper_9::MapCPUMemory()
+{
+    const uint32_t bankSize = 0x2000;
+    m_bus.MapCPURead(0x8000, bankSize, &m_pPrg[uint32_t(m_prgBankSelect) * bankSize]);
+    m_bus.MapCPURead(0xA000, bankSize * 3, &m_pPrg[m_nProgramSize - bankSize * 3]);
+}
+
+void CartMapper_9::MapPPUMemory()
+{
+    // Current latch sets chr bank - any other latch value reads 0 through ppuRead
+    uint8_t* pBank0 = nullptr;
+    if(m_latch0 == 0xFD)
+    {
+        pBank0 = &m_pChr[0x1000 * uint32_t(m_chrBankSelect0)];
+    }
+    else if(m_latch0 == 0xFE)
+    {
+        pBank0 = &m_pChr[0x1000 * uint32_t(m_chrBankSelect1)];
+    }
+    
+    uint8_t* pBank1 = nullptr;
+    if(m_latch1 == 0xFD)
+    {
+        pBank1 = &m_pChr[0x1000 * uint32_t(m_chrBankSelect2)];
+    }
+    else if(m_latch1 == 0xFE)
+    {
+        pBank1 = &m_pChr[0x1000 * uint32_t(m_chrBankSelect3)];
+    }
+    
+    m_bus.MapPPURead(0x0000, 0x1000, pBank0);
+    m_bus.MapPPURead(0x1000, 0x1000, pBank1);
+}
+
 uint8_t CartMapper_9::ppuRead(uint16_t address)
 {
     uint8_t byte = 0;
@@ -119,7 +165,17 @@ uint8_t CartMapper_9::ppuRead(uint16_t address)
             byte = m_pChr[(0x1000 * uint32_t(m_chrBankSelect3)) + (address - 0x1000)];
         }
     }
-    // Latch updates
+    PPUBusRead(address);
+    
+    return byte;
+}
+
+void CartMapper_9::PPUBusRead(uint16_t address)
+{
+    // Latch updates - the fetch itself still sees the old bank
+    uint8_t latch0 = m_latch0;
+    uint8_t latch1 = m_latch1;
+    
     if(address == 0x0FD8)
     {
         m_latch0 = 0xFD;
@@ -137,7 +193,10 @@ uint8_t CartMapper_9::ppuRead(uint16_t address)
         m_latch1 = 0xFE;
     }
     
-    return byte;
+    if(m_latch0 != latch0 || m_latch1 != latch1)
+    {
+        MapPPUMemory();
+    }
 }
 
 void CartMapper_9::ppuWrite(uint16_t address, uint8_t byte)
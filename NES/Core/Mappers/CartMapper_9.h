@@ -10,12 +10,20 @@
 
 #include "CartMapperFactory.h"
 
-class CartMapper_9 : public Mapper
+class CartMapper_9 : public Mapper, public PPUBusObserver
 {
 public:
     BUS_HEADER_DECL
     MAPPER_HEADER_DECL
     SERIALISABLE_DECL
+    
+    virtual void PPUBusRead(uint16_t address) override;
+    
+private:
+
+    void MapCPUMemory();
+    void MapPPUMemory();
+    
 private:
 
     uint8_t m_prgBankSelect;
@@ -5,9 +5,146 @@
 //
 
 #include "PPUNES.h"
+#include "VideoOutput.h"
 #include <stdio.h>
 #include <string.h>
 
+// 341 x 262 = [scanline time + hBlank time in scanline dots] X [scanline count + vBlank time in scanlines]
+const uint32_t kDotsPerScanline     = 341;
+const uint32_t kScanlinesPerFrame   = 262;
+const uint32_t kTicksPerFrame       = kDotsPerScanline * kScanlinesPerFrame;
+
+// VBlank flag set at scanline 241 dot 1, cleared at scanline 261 dot 1
+const uint32_t kVBlankStartTick     = 241 * kDotsPerScanline + 1;
+const uint32_t kVBlankClearTick     = 261 * kDotsPerScanline + 1;
+
+// NMI delay after vblank for CompatabilityModeFlag_NMI
+const uint32_t kNMISurpressTicks    = 1000;
+
+// No sprite 0 hit before the pre-render line
+const uint32_t kNoSprite0Hit        = 0xFFFFFFFF;
+
+// 1KB of VRAM used by each of the $2000, $2400, $2800, $2C00 nametables - indexed by MirrorMode
+const uint8_t kNametableMirror[5][4] =
+{
+    {0, 0, 1, 1},                   // VRAM_MIRROR_H
+    {0, 1, 0, 1},                   // VRAM_MIRROR_V
+    {0, 1, 2, 3},                   // VRAM_MIRROR_CART4
+    {0, 0, 0, 0},                   // VRAM_MIRROR_SINGLEA
+    {1, 1, 1, 1},                   // VRAM_MIRROR_SINGLEB
+};
+
+// Pattern bit planes decoded to one byte per pixel, leftmost first - built once so rows are never bit sliced per pixel
+struct PatternDecodeTable
+{
+    PatternDecodeTable()
+    {
+        for(uint32_t plane = 0;plane < 256;++plane)
+        {
+            for(uint32_t pixel = 0;pixel < 8;++pixel)
+            {
+                m_pixels[plane][pixel] = (plane >> (7 - pixel)) & 1;
+            }
+            
+            // Horizontally flipped sprite rows
+            m_reverse[plane] = 0;
+            for(uint32_t bit = 0;bit < 8;++bit)
+            {
+                m_reverse[plane] |= ((plane >> bit) & 1) << (7 - bit);
+            }
+        }
+    }
+    
+    uint8_t m_pixels[256][8];
+    uint8_t m_reverse[256];
+};
+
+static const PatternDecodeTable kPatternDecode;
+
+// Four planes to 8 pixels of (plane3 << 3) | (plane2 << 2) | (plane1 << 1) | plane0 - bytes can't carry into each other
+static inline void DecodePlanes(uint8_t* pPixels, uint8_t plane0, uint8_t plane1, uint8_t plane2, uint8_t plane3)
+{
+    uint64_t pixels0, pixels1, pixels2, pixels3;
+    memcpy(&pixels0, kPatternDecode.m_pixels[plane0], 8);
+    memcpy(&pixels1, kPatternDecode.m_pixels[plane1], 8);
+    memcpy(&pixels2, kPatternDecode.m_pixels[plane2], 8);
+    memcpy(&pixels3, kPatternDecode.m_pixels[plane3], 8);
+    
+    uint64_t pixels = pixels0 | (pixels1 << 1) | (pixels2 << 2) | (pixels3 << 3);
+    memcpy(pPixels, &pixels, 8);
+}
+
+// Coarse X to the next tile, wrapping into the horizontal nametable
+static inline uint16_t IncrementTileAddress(uint16_t address)
+{
+    // break apart
+    uint16_t coarseX =      (address >> 0) & 31;
+    uint16_t coarseY =      (address >> 5) & 31;
+    uint16_t nametable =    (address >> 10) & 3;
+    uint16_t fineY =        (address >> 12) & 7;
+        
+    // update coarse for next tile fetch
+    if(coarseX < 31)
+    {
+        ++coarseX;
+    }
+    else
+    {
+        coarseX = 0;
+        nametable ^= 1;
+    }
+
+    // put back together
+    return  ((coarseX & 31) << 0) |
+            ((coarseY & 31) << 5) |
+            ((nametable & 3) << 10) |
+            ((fineY & 7) << 12);
+}
+
+// Fine Y to the next line, wrapping coarse Y into the vertical nametable
+static inline uint16_t IncrementLineAddress(uint16_t address)
+{
+    // break apart
+    uint16_t coarseX =      (address >> 0) & 31;
+    uint16_t coarseY =      (address >> 5) & 31;
+    uint16_t nametable =    (address >> 10) & 3;
+    uint16_t fineY =        (address >> 12) & 7;
+    
+    // update coarse for next tile fetch
+    if(fineY < 7)
+    {
+        ++fineY;
+    }
+    else
+    {
+        fineY = 0;
+        if(coarseY == 29)
+        {
+            coarseY = 0;
+            nametable ^= 2;
+        }
+        else if(coarseY == 31)
+        {
+            coarseY = 0;
+        }
+        else
+        {
+            ++coarseY;
+        }
+    }
+    
+    // put back together
+    return  ((coarseX & 31) << 0) |
+            ((coarseY & 31) << 5) |
+            ((nametable & 3) << 10) |
+            ((fineY & 7) << 12);
+}
+
+// Sprite evaluation and pattern fetches on visible lines
+const uint16_t kSpriteEvaluationStartDot    = 65;
+const uint16_t kSpriteFetchStartDot         = 257;
+const uint16_t kSpriteFetchEndDot           = 320;
+
 enum FlagControl : uint8_t
 {
     // [bit 1 | bit 0]  - 0 = $2000; 1 = $2400; 2 = $2800; 3 = $2C00 = 0x2000 + (0x0400 * (CTRL & mask))
@@ -65,17 +202,18 @@ PPUNES::PPUNES(SystemIOBus& bus)
 : m_bus(bus)
 , m_compatibiltyMode(0)
 , m_mirrorMode(VRAM_MIRROR_H)
+, m_pCartVRAM(nullptr)
+, m_pPatternObserver(nullptr)
 , m_secondaryOAMWrite(0)
 , m_spriteZero(0xFF)
+, m_spriteLinesHeight(0)
+, m_spriteEvaluation(SPRITE_EVALUATION_SCANLINE)
 , m_ctrl(0)
 , m_mask(0)
 , m_status(0)
 , m_oamAddress(0)
 , m_portLatch(0)
 , m_ppuDataBuffer(0)
-, m_scanline(0)
-, m_scanlineDot(0)
-, m_nmiSurpress(0)
 , m_ppuAddress(0)
 , m_ppuTAddress(0)
 , m_ppuWriteToggle(0)
@@ -85,11 +223,18 @@ PPUNES::PPUNES(SystemIOBus& bus)
 , m_bgPatternShift1(0)
 , m_bgPalletteShift0(0)
 , m_bgPalletteShift1(0)
-, m_pVideoOutput(nullptr)
+, m_scanline(0)
+, m_scanlineDot(0)
+, m_scanlineBatchDot(0)
+, m_spriteEvaluationDot(0)
+, m_nmiSignalCycle(0)
 {
     memset(m_vram, 0x00, sizeof(m_vram));
     memset(m_primaryOAM, 0xFF, sizeof(m_primaryOAM));
     memset(m_secondaryOAM, 0xFF, sizeof(m_secondaryOAM));
+    memset(m_spriteLines, 0x00, sizeof(m_spriteLines));
+    memset(m_patternMap, 0x00, sizeof(m_patternMap));
+    UpdateNametableMap();
 }
 
 PPUNES::~PPUNES()
@@ -102,6 +247,7 @@ void PPUNES::Load(Archive& rArchive)
     rArchive >> m_compatibiltyMode;
     rArchive >> m_mirrorMode;
     rArchive.ReadBytes(m_vram, sizeof(m_vram));
+    UpdateNametableMap();
     rArchive.ReadBytes(m_pallette, sizeof(m_pallette));
     rArchive.ReadBytes(m_primaryOAM, 256);
     rArchive.ReadBytes(m_secondaryOAM, 32);
@@ -125,11 +271,27 @@ void PPUNES::Load(Archive& rArchive)
     rArchive.ReadBytes(m_scanlineSprites, sizeof(ScanlineSprite) * 8);
     rArchive >> m_scanline;
     rArchive >> m_scanlineDot;
-    rArchive >> m_nmiSurpress;
+    m_scanlineBatchDot = 0;
+    m_spriteEvaluationDot = 0;
+    m_spriteLinesHeight = 0;
+    
+    // Archived as ticks remaining - saved state is always in step
+    uint16_t nmiSurpress = 0;
+    rArchive >> nmiSurpress;
+    m_nmiSignalCycle = nmiSurpress > 0 ? m_bus.GetCycleCount() + nmiSurpress : 0;
 }
 
 void PPUNES::Save(Archive& rArchive) const
 {
+#if DEBUG
+    // Batched dots must be drawn and sprites evaluated first - see SyncScanline
+    if((m_scanlineBatchDot != 0 && m_scanlineDot > m_scanlineBatchDot) ||
+       (m_spriteEvaluationDot != 0 && m_scanlineDot > m_spriteEvaluationDot))
+    {
+        *(volatile char*)(0) = 'P' | 'P' | 'U';
+    }
+#endif
+    
     rArchive << m_compatibiltyMode;
     rArchive << m_mirrorMode;
     rArchive.WriteBytes(m_vram, sizeof(m_vram));
@@ -156,16 +318,31 @@ void PPUNES::Save(Archive& rArchive) const
     rArchive.WriteBytes(m_scanlineSprites, sizeof(ScanlineSprite) * 8);
     rArchive << m_scanline;
     rArchive << m_scanlineDot;
-    rArchive << m_nmiSurpress;
+    
+    uint16_t nmiSurpress = 0;
+    if(m_nmiSignalCycle != 0)
+    {
+        nmiSurpress = uint16_t(m_nmiSignalCycle - m_bus.GetPPUCycleCount());
+    }
+    rArchive << nmiSurpress;
 }
 
 void PPUNES::SetVideoOutputDataPtr(uint32_t* pVideoOutData)
 {
-    m_pVideoOutput = pVideoOutData;
+    SetVideoOutput(VideoOutputDesc(pVideoOutData, VIDEO_FORMAT_BGRA8));
+}
+
+void PPUNES::SetVideoOutput(const VideoOutputDesc& output)
+{
+    SyncScanline();
+    m_videoOutput = output;
+    m_videoOutput.m_stride = VideoLineStride(output);
 }
 
 void PPUNES::SetCompatabilityMode(uint8_t flag)
 {
+    SyncScanline();
+    
     if(flag == 0)
     {
         m_compatibiltyMode = 0;
@@ -176,9 +353,18 @@ void PPUNES::SetCompatabilityMode(uint8_t flag)
     }
 }
 
+void PPUNES::SetSpriteEvaluation(SPRITE_EVALUATION evaluation)
+{
+    // Takes effect from the next scanline
+    m_spriteEvaluation = evaluation;
+}
+
 void PPUNES::SetMirrorMode(MirrorMode mode)
 {
+    SyncScanline();
     m_mirrorMode = mode;
+    UpdateNametableMap();
+    CheckScanlineBatch();
 }
 
 MirrorMode PPUNES::GetMirrorMode() const
@@ -186,6 +372,70 @@ MirrorMode PPUNES::GetMirrorMode() const
     return m_mirrorMode;
 }
 
+void PPUNES::MapPatternMemory(uint16_t address, uint32_t size, uint8_t* pMemory)
+{
+#if DEBUG
+    // Only whole 1KB pages of the pattern tables can be mapped
+    if((address & 0x3FF) != 0 || (size & 0x3FF) != 0 || uint32_t(address) + size > 0x2000)
+    {
+        *(volatile char*)(0) = 'C' | 'H' | 'R';
+    }
+#endif
+    
+    SyncScanline();
+    
+    uint32_t firstPage = address >> 10;
+    uint32_t pageCount = size >> 10;
+    for(uint32_t page = 0;page < pageCount;++page)
+    {
+        m_patternMap[firstPage + page] = pMemory != nullptr ? pMemory + page * 0x400 : nullptr;
+    }
+    
+    CheckScanlineBatch();
+}
+
+void PPUNES::SetPatternObserver(PPUBusObserver* pObserver)
+{
+    SyncScanline();
+    m_pPatternObserver = pObserver;
+    CheckScanlineBatch();
+}
+
+void PPUNES::SetCartVRAM(uint8_t* pCartVRAM)
+{
+    SyncScanline();
+    m_pCartVRAM = pCartVRAM;
+    UpdateNametableMap();
+    CheckScanlineBatch();
+}
+
+void PPUNES::ResetCartMemory()
+{
+    SyncScanline();
+    memset(m_patternMap, 0x00, sizeof(m_patternMap));
+    m_pPatternObserver = nullptr;
+    m_pCartVRAM = nullptr;
+    UpdateNametableMap();
+    CheckScanlineBatch();
+}
+
+void PPUNES::UpdateNametableMap()
+{
+    for(uint32_t table = 0;table < 4;++table)
+    {
+        uint32_t vramOffset = uint32_t(kNametableMirror[m_mirrorMode][table]) * 0x400;
+        if(m_mirrorMode == VRAM_MIRROR_CART4)
+        {
+            // no mirroring - all exist via on cart ram, without it the bus handles them
+            m_nametableMap[table] = m_pCartVRAM != nullptr ? m_pCartVRAM + vramOffset : nullptr;
+        }
+        else
+        {
+            m_nametableMap[table] = m_vram + vramOffset;
+        }
+    }
+}
+
 void PPUNES::SetFlag(uint8_t flag, uint8_t& ppuRegister)
 {
     ppuRegister |= flag;
@@ -213,7 +463,10 @@ void PPUNES::PowerOn()
     m_ppuDataBuffer = 0;
     m_scanline = 0;
     m_scanlineDot = 0;
-    m_nmiSurpress = 0;
+    m_scanlineBatchDot = 0;
+    m_spriteEvaluationDot = 0;
+    m_nmiSignalCycle = 0;
+    m_bus.CancelEvent(this, PPU_EVENT_NMI);
     
     m_ppuTAddress = 0;
     m_ppuAddress = 0;
@@ -229,6 +482,7 @@ void PPUNES::PowerOn()
     memset(m_vram, 0x00, sizeof(m_vram));
     memset(m_primaryOAM, 0xFF, sizeof(m_primaryOAM));
     memset(m_secondaryOAM, 0xFF, sizeof(m_secondaryOAM));
+    m_spriteLinesHeight = 0;
 }
 
 void PPUNES::Reset()
@@ -243,7 +497,10 @@ void PPUNES::Reset()
     m_ppuDataBuffer = 0;
     m_scanline = 0;
     m_scanlineDot = 0;
-    m_nmiSurpress = 0;
+    m_scanlineBatchDot = 0;
+    m_spriteEvaluationDot = 0;
+    m_nmiSignalCycle = 0;
+    m_bus.CancelEvent(this, PPU_EVENT_NMI);
     
     m_ppuTAddress = 0;
     m_ppuAddress = 0;
@@ -258,20 +515,29 @@ void PPUNES::Reset()
     
     memset(m_vram, 0x00, sizeof(m_vram));
     memset(m_primaryOAM, 0xFF, sizeof(m_primaryOAM));
-    memset(m_secondaryOAM, 0xFF, sizeof(m_secondaryOAM));    
+    memset(m_secondaryOAM, 0xFF, sizeof(m_secondaryOAM));
+    m_spriteLinesHeight = 0;
 }
 
-void PPUNES::Tick()
+void PPUNES::ScheduleEvents()
 {
-    if(m_nmiSurpress > 0)
+    if(m_nmiSignalCycle != 0)
     {
-        --m_nmiSurpress;
-        if(m_nmiSurpress == 0)
-        {
-            m_bus.SignalNMI(true);
-        }
+        m_bus.ScheduleEvent(this, PPU_EVENT_NMI, m_nmiSignalCycle);
     }
-    
+}
+
+void PPUNES::SystemEvent(uint32_t eventID, uint64_t cycleCount)
+{
+    if(eventID == PPU_EVENT_NMI)
+    {
+        m_nmiSignalCycle = 0;
+        m_bus.SignalNMI(true);
+    }
+}
+
+void PPUNES::Tick()
+{
     // VBlank set
     if(m_scanline == 241 && m_scanlineDot == 1)
     {
@@ -281,7 +547,8 @@ void PPUNES::Tick()
         {
             if(m_compatibiltyMode & CompatabilityModeFlag_NMI)
             {
-                m_nmiSurpress = 1000;
+                m_nmiSignalCycle = m_bus.GetPPUCycleCount() + kNMISurpressTicks;
+                m_bus.ScheduleEvent(this, PPU_EVENT_NMI, m_nmiSignalCycle);
             }
             else
             {
@@ -307,6 +574,7 @@ void PPUNES::Tick()
 //    }
     
     // Main update draw, 0-239 is the visible scan lines, 261 is the pre-render line
+    bool bBatchedDot = false;
     if(m_scanline >= 0 && m_scanline <= 239)
     {
         if(m_scanlineDot >= 1 && m_scanlineDot <= 64)
@@ -315,7 +583,20 @@ void PPUNES::Tick()
         }
         else if(m_scanlineDot >= 65 && m_scanlineDot <= 256)
         {
-            if(TestFlag(MASK_SPRITE_SHOW, m_mask))
+            // Evaluated scanlines run at the end or when the CPU could see the result
+            if(m_scanlineDot == 65 && m_spriteEvaluation == SPRITE_EVALUATION_SCANLINE)
+            {
+                m_spriteEvaluationDot = 65;
+            }
+            
+            if(m_spriteEvaluationDot != 0)
+            {
+                if(m_scanlineDot == 256)
+                {
+                    EvaluateSprites(256);
+                }
+            }
+            else if(TestFlag(MASK_SPRITE_SHOW, m_mask))
             {
                 SpriteEvaluation();
             }
@@ -333,14 +614,30 @@ void PPUNES::Tick()
             }
         }
         
-        // Output current pixel
+        // Output current pixel - batched lines are drawn at the end or when something they read changes
         if(m_scanlineDot >= 1 && m_scanlineDot <= 256)
         {
-            GenerateVideoPixel();
+            if(m_scanlineDot == 1 && CanBatchScanline())
+            {
+                m_scanlineBatchDot = 1;
+            }
+            
+            if(m_scanlineBatchDot != 0)
+            {
+                bBatchedDot = true;
+                if(m_scanlineDot == 256)
+                {
+                    RenderScanline(256);
+                }
+            }
+            else
+            {
+                GenerateVideoPixel();
+            }
         }
     }
     
-    if(TestFlag(MASK_BACKGROUND_SHOW, m_mask))
+    if(TestFlag(MASK_BACKGROUND_SHOW, m_mask) && !bBatchedDot)
     {
         if( ((m_scanline >= 0 && m_scanline <= 239) || m_scanline == 261) &&
             (m_scanlineDot > 0))
@@ -363,53 +660,643 @@ void PPUNES::Tick()
     }
 }
 
-void PPUNES::ClearSecondaryOAM()
+uint32_t PPUNES::TicksUntilFrameTick(uint32_t frameTick) const
 {
-    if(m_scanlineDot >= 1 && m_scanlineDot <= 64)
+    const uint32_t currentTick = uint32_t(m_scanline) * kDotsPerScanline + m_scanlineDot;
+    const uint32_t ticksBefore = (frameTick + kTicksPerFrame - currentTick) % kTicksPerFrame;
+    
+    // Include the tick itself
+    return ticksBefore + 1;
+}
+
+uint32_t PPUNES::TicksUntilVBlank() const
+{
+    return TicksUntilFrameTick(kVBlankStartTick);
+}
+
+uint32_t PPUNES::TicksUntilSignal(bool bBusAccess) const
+{
+    // VBlank set and flags clear on the pre-render line
+    uint32_t ticks = TicksUntilFrameTick(kVBlankStartTick);
+    uint32_t ticksClear = TicksUntilFrameTick(kVBlankClearTick);
+    if(ticksClear < ticks)
     {
-        if(m_scanlineDot == 64)
+        ticks = ticksClear;
+    }
+    
+    if(bBusAccess && ticks > 1)
+    {
+        const bool bRenderLine = m_scanline <= 239 || m_scanline == 261;
+        
+        if((m_mask & MASK_BACKGROUND_SHOW) != 0 && bRenderLine)
         {
-            m_spriteZero = 0xFF;
-            memset(m_secondaryOAM, 0xFF, sizeof(m_secondaryOAM));
+            // Fetches all through the line
+            ticks = 1;
+        }
+        else
+        {
+            // Sprite fetches happen on every visible line even with rendering off
+            uint32_t spriteFetchTick = 0 * kDotsPerScanline + kSpriteFetchStartDot;
+            if(m_scanline <= 239)
+            {
+                if(m_scanlineDot >= kSpriteFetchStartDot && m_scanlineDot <= kSpriteFetchEndDot)
+                {
+                    spriteFetchTick = uint32_t(m_scanline) * kDotsPerScanline + m_scanlineDot;
+                }
+                else if(m_scanlineDot < kSpriteFetchStartDot)
+                {
+                    spriteFetchTick = uint32_t(m_scanline) * kDotsPerScanline + kSpriteFetchStartDot;
+                }
+                else if(m_scanline < 239)
+                {
+                    spriteFetchTick = uint32_t(m_scanline + 1) * kDotsPerScanline + kSpriteFetchStartDot;
+                }
+            }
+            
+            uint32_t ticksFetch = TicksUntilFrameTick(spriteFetchTick);
+            if(ticksFetch < ticks)
+            {
+                ticks = ticksFetch;
+            }
         }
     }
+    
+    return ticks;
 }
 
-void PPUNES::SpriteEvaluation()
+uint32_t PPUNES::TicksUntilSprite0Hit() const
 {
-    // Odd data read even data write
-    if(m_scanlineDot >= 65 && m_scanlineDot <= 256)
+    uint32_t hitTick = 0;
+    if(!PredictSprite0Hit(239, hitTick))
     {
-        if(m_scanlineDot % 2 == 0)
+        return 1;
+    }
+    
+    if(hitTick == kNoSprite0Hit)
+    {
+        return TicksUntilFrameTick(kVBlankClearTick);
+    }
+    
+    // Due on a batched dot not drawn yet
+    if(m_scanline <= 239 && hitTick < uint32_t(m_scanline) * kDotsPerScanline + m_scanlineDot)
+    {
+        return 1;
+    }
+    
+    return TicksUntilFrameTick(hitTick);
+}
+
+uint32_t PPUNES::TicksUntilSpriteOverflow()
+{
+    // Already set or no sprite evaluation - nothing until the pre-render line clears it
+    if((m_status & STATUS_SPRITE_OVERFLOW) || !(m_mask & MASK_SPRITE_SHOW))
+    {
+        return TicksUntilFrameTick(kVBlankClearTick);
+    }
+    
+    // Same sprite masks as the scanline evaluation
+    const uint8_t spriteHeight = (m_ctrl & CTRL_SPRITE_SIZE) ? 16 : 8;
+    if(m_spriteLinesHeight != spriteHeight)
+    {
+        m_spriteLinesHeight = spriteHeight;
+        UpdateSpriteLines();
+    }
+    
+    // Carry on from the current line's evaluation or start the next visible line - OAMADDR is only reset on visible lines
+    uint16_t scanline = 0;
+    uint8_t oamAddress = m_oamAddress;
+    uint32_t spriteCount = m_secondaryOAMWrite / 4;
+    uint32_t evaluated = 0;
+    if(m_scanline <= 239)
+    {
+        // Even dots 66 - 256 each evaluate one entry, scanline evaluation can be behind the dot
+        const uint16_t evaluationDot = m_spriteEvaluationDot != 0 ? m_spriteEvaluationDot : m_scanlineDot;
+        evaluated = evaluationDot > 66 ? (evaluationDot - 1) / 2 - 32 : 0;
+        if(evaluated > 96)
         {
-            uint8_t spriteTop = m_primaryOAM[m_oamAddress];
-            uint8_t spriteBottom = spriteTop + (TestFlag(CTRL_SPRITE_SIZE, m_ctrl) ? 15 : 7);
-            
-            if(m_scanline >= spriteTop && m_scanline <= spriteBottom)
+            evaluated = 96;
+        }
+        scanline = m_scanline;
+    }
+    
+    for(;scanline <= 239;++scanline)
+    {
+        // A misaligned OAMADDR compares bytes other than Y, the sprite masks don't cover that
+        if((oamAddress & 0x3) != 0)
+        {
+            return 1;
+        }
+        
+        // From sprite 0 the 96 entries are every sprite then the first 32 again
+        const uint64_t lineSprites = m_spriteLines[scanline];
+        const bool bFromStart = evaluated == 0 && oamAddress == 0;
+        if(!bFromStart || spriteCount + __builtin_popcountll(lineSprites) + __builtin_popcountll(lineSprites & 0xFFFFFFFF) > 8)
+        {
+            for(uint32_t evaluation = evaluated;evaluation < 96;++evaluation)
             {
-                if(m_secondaryOAMWrite < 32)
+                const uint32_t sprite = ((oamAddress >> 2) + evaluation - evaluated) & 63;
+                if((lineSprites >> sprite) & 1)
                 {
-                    m_secondaryOAM[m_secondaryOAMWrite + 0] = m_primaryOAM[m_oamAddress + 0];
-                    m_secondaryOAM[m_secondaryOAMWrite + 1] = m_primaryOAM[m_oamAddress + 1];
-                    m_secondaryOAM[m_secondaryOAMWrite + 2] = m_primaryOAM[m_oamAddress + 2];
-                    m_secondaryOAM[m_secondaryOAMWrite + 3] = m_primaryOAM[m_oamAddress + 3];
-                    
-                    m_secondaryOAMWrite += 4;
-                    
-                    if(m_oamAddress == 0)
+                    if(spriteCount == 8)
                     {
-                        m_spriteZero = 1;
+                        // Due on a dot scanline evaluation hasn't caught up with
+                        const uint16_t dot = 66 + evaluation * 2;
+                        if(scanline == m_scanline && dot < m_scanlineDot)
+                        {
+                            return 1;
+                        }
+                        return TicksUntilFrameTick(uint32_t(scanline) * kDotsPerScanline + dot);
                     }
+                    ++spriteCount;
+                }
+            }
+        }
+        
+        oamAddress = 0;
+        spriteCount = 0;
+        evaluated = 0;
+    }
+    
+    return TicksUntilFrameTick(kVBlankClearTick);
+}
+
+uint32_t PPUNES::TicksUntilStatusChange()
+{
+    // Sprite 0 hit and overflow are never later than the pre-render line clearing them
+    uint32_t ticks = TicksUntilVBlank();
+    
+    const uint32_t ticksSprite0 = TicksUntilSprite0Hit();
+    if(ticksSprite0 < ticks)
+    {
+        ticks = ticksSprite0;
+    }
+    
+    const uint32_t ticksOverflow = TicksUntilSpriteOverflow();
+    if(ticksOverflow < ticks)
+    {
+        ticks = ticksOverflow;
+    }
+    
+    return ticks;
+}
+
+uint32_t PPUNES::TicksUntilOAMAccess() const
+{
+    // From the last sprite fetch of line 239 to the first evaluation of line 0 nothing reads OAM or resets OAMADDR
+    const bool bFirstLine = m_scanline == 0 && m_scanlineDot < kSpriteEvaluationStartDot;
+    const bool bLastLine = m_scanline == 239 && m_scanlineDot > kSpriteFetchEndDot;
+    if(m_scanline <= 239 && !bFirstLine && !bLastLine)
+    {
+        return 0;
+    }
+    
+    return TicksUntilFrameTick(kSpriteEvaluationStartDot) - 1;
+}
+
+bool PPUNES::PredictSprite0Hit(uint16_t lastScanline, uint32_t& frameTick) const
+{
+    // Hit by the end of lastScanline with nothing written in between - scanline * kDotsPerScanline + dot, kNoSprite0Hit for none
+    frameTick = kNoSprite0Hit;
+    
+    // The compatibility hit ignores the background
+    if(m_compatibiltyMode & CompatabilityModeFlag_SPRITE0)
+    {
+        return false;
+    }
+    
+    // Already set or nothing for sprite 0 to hit
+    if((m_status & STATUS_SPRITE0_HIT) || !(m_mask & MASK_SPRITE_SHOW) || !(m_mask & MASK_BACKGROUND_SHOW))
+    {
+        return true;
+    }
+    
+    // Tiles and sprite rows are read straight from the memory maps
+    if(!CanBatchScanline())
+    {
+        return false;
+    }
+    
+    // Each line after this one starts from v with the horizontal part copied from t
+    const uint16_t kHorizontalBits = 0x041F;
+    
+    ScanlineSprite sprite = m_scanlineSprites[0];
+    uint16_t lineAddress = m_ppuAddress;
+    uint16_t scanline = 0;
+    bool bSpriteFetched = true;
+    
+    if(m_scanline <= 239)
+    {
+        // The rest of this line from the first dot not drawn yet
+        if(m_scanlineDot <= 256)
+        {
+            const uint16_t firstDot = m_scanlineBatchDot != 0 ? m_scanlineBatchDot : (m_scanlineDot > 0 ? m_scanlineDot : 1);
+            if(sprite.m_spriteZero)
+            {
+                // Two tiles in the shift registers then fetches from v
+                const uint16_t shifted = (firstDot - 1) % 8;
+                const uint16_t tileOpacity = (m_bgPatternShift0 | m_bgPatternShift1) >> shifted;
+                
+                const uint16_t hitDot = Sprite0HitDot(sprite, firstDot, tileOpacity, m_ppuAddress);
+                if(hitDot != 0)
+                {
+                    frameTick = uint32_t(m_scanline) * kDotsPerScanline + hitDot;
+                    return true;
+                }
+            }
+            
+            lineAddress = IncrementLineAddress(lineAddress);
+        }
+        
+        scanline = m_scanline + 1;
+        
+        // Slot 0 for the next line is fetched on dot 257
+        bSpriteFetched = m_scanlineDot > kSpriteFetchStartDot;
+    }
+    else
+    {
+        // Line 0 takes sprites fetched on line 239 and v entirely from t after the pre-render line
+        lineAddress = m_ppuTAddress;
+    }
+    
+    for(;scanline <= lastScanline;++scanline)
+    {
+        if(!bSpriteFetched)
+        {
+            // Sprites for this line are evaluated and fetched on the line before
+            const uint16_t evaluationLine = scanline - 1;
+            bool bPredicted = false;
+            
+            if(evaluationLine == m_scanline)
+            {
+                // Part way through - carry on from where evaluation is up to
+                if(m_scanlineDot <= 64)
+                {
+                    bPredicted = PredictSprite0Slot(evaluationLine, m_oamAddress, 96, 0, false, sprite);
                 }
                 else
                 {
-                    SetFlag(STATUS_SPRITE_OVERFLOW, m_status);
+                    const uint16_t evaluationDot = m_spriteEvaluationDot != 0 ? m_spriteEvaluationDot : m_scanlineDot;
+                    const uint32_t evaluationCount = evaluationDot <= 256 ? 256 / 2 - (evaluationDot - 1) / 2 : 0;
+                    bPredicted = PredictSprite0Slot(evaluationLine, m_oamAddress, evaluationCount, m_secondaryOAMWrite, m_spriteZero == 1, sprite);
                 }
             }
+            else
+            {
+                // OAMADDR is cleared on dots 257 - 320 of each visible line, line 0 evaluates from wherever it was left
+                const bool bOAMAddressCleared = evaluationLine > 0 && (evaluationLine - 1 != m_scanline || m_scanlineDot <= kSpriteFetchEndDot);
+                bPredicted = PredictSprite0Slot(evaluationLine, bOAMAddressCleared ? 0 : m_oamAddress, 96, 0, false, sprite);
+            }
+            
+            if(!bPredicted)
+            {
+                return false;
+            }
+        }
+        bSpriteFetched = false;
+        
+        if(sprite.m_spriteZero)
+        {
+            const uint16_t tileAddress = (lineAddress & ~kHorizontalBits) | (m_ppuTAddress & kHorizontalBits);
+            const uint16_t secondTileAddress = IncrementTileAddress(tileAddress);
+            const uint16_t tileOpacity = (uint16_t(TileOpacity(tileAddress)) << 8) | TileOpacity(secondTileAddress);
             
-            m_oamAddress += 4;
+            const uint16_t hitDot = Sprite0HitDot(sprite, 1, tileOpacity, IncrementTileAddress(secondTileAddress));
+            if(hitDot != 0)
+            {
+                frameTick = uint32_t(scanline) * kDotsPerScanline + hitDot;
+                return true;
+            }
+        }
+        
+        lineAddress = IncrementLineAddress(lineAddress);
+    }
+    
+    return true;
+}
+
+bool PPUNES::PredictSprite0Slot(uint16_t scanline, uint8_t oamAddress, uint32_t evaluationCount, uint8_t secondaryOAMWrite, bool bSpriteZero, ScanlineSprite& sprite) const
+{
+    // What evaluation then the slot 0 fetch would leave - see EvaluateSprite and SpriteFetch
+    const uint8_t spriteHeight = (m_ctrl & CTRL_SPRITE_SIZE) ? 16 : 8;
+    const uint8_t* pSlot = m_secondaryOAM;
+    
+    if(oamAddress == 0 && secondaryOAMWrite == 0)
+    {
+        // Sprite 0 is first - anything before it in slot 0 can't be sprite zero flagged
+        evaluationCount = evaluationCount > 0 ? 1 : 0;
+    }
+    
+    for(uint32_t evaluation = 0;evaluation < evaluationCount;++evaluation)
+    {
+        if((oamAddress & 0x3) != 0)
+        {
+            return false;
+        }
+        
+        const uint8_t spriteTop = m_primaryOAM[oamAddress];
+        const uint8_t spriteBottom = spriteTop + spriteHeight - 1;
+        if(scanline >= spriteTop && scanline <= spriteBottom && secondaryOAMWrite < 32)
+        {
+            if(secondaryOAMWrite == 0)
+            {
+                pSlot = &m_primaryOAM[oamAddress];
+            }
+            secondaryOAMWrite += 4;
+            bSpriteZero = bSpriteZero || oamAddress == 0;
+        }
+        
+        oamAddress += 4;
+    }
+    
+    sprite.m_patternLatch = 0;
+    sprite.m_patternShift0 = 0;
+    sprite.m_patternShift1 = 0;
+    sprite.m_attribute = 0;
+    sprite.m_counter = 0;
+    sprite.m_spriteZero = 0;
+    
+    if(secondaryOAMWrite > 0 && bSpriteZero)
+    {
+        const uint16_t spriteLineAddress = SpriteLineAddress(scanline, pSlot[0], pSlot[1], pSlot[2]);
+        uint8_t spritePlane0 = m_patternMap[spriteLineAddress >> 10][spriteLineAddress & 0x3FF];
+        uint8_t spritePlane1 = m_patternMap[(spriteLineAddress + 8) >> 10][(spriteLineAddress + 8) & 0x3FF];
+        
+        if((pSlot[2] & (1 << 6)) != 0)
+        {
+            spritePlane0 = kPatternDecode.m_reverse[spritePlane0];
+            spritePlane1 = kPatternDecode.m_reverse[spritePlane1];
+        }
+        
+        sprite.m_patternShift0 = spritePlane0;
+        sprite.m_patternShift1 = spritePlane1;
+        sprite.m_attribute = pSlot[2];
+        sprite.m_counter = pSlot[3];
+        sprite.m_spriteZero = 1;
+    }
+    
+    return true;
+}
+
+uint16_t PPUNES::Sprite0HitDot(const ScanlineSprite& sprite, uint16_t firstDot, uint16_t tileOpacity, uint16_t tileAddress) const
+{
+    // Sprite pixels laid out as RenderScanline does - the latch until the counter runs out then the pattern
+    // tileOpacity has the tiles in stream slots (firstDot - 1) / 8 and the one after, later slots are fetched from tileAddress on
+    const bool bBackgroundL8 = (m_mask & MASK_BACKGROUND_L8) != 0;
+    const bool bSpriteL8 = (m_mask & MASK_SPRITE_L8) != 0;
+    const uint16_t firstSlot = (firstDot - 1) / 8;
+    const uint16_t shiftStart = sprite.m_counter > 0 ? sprite.m_counter - 1 : 0;
+    const uint8_t spritePattern = sprite.m_patternShift0 | sprite.m_patternShift1;
+    
+    uint16_t fetchedSlot = firstSlot + 2;
+    uint8_t fetchedOpacity = 0;
+    
+    for(uint16_t offset = 0;offset <= shiftStart + 8;++offset)
+    {
+        const uint16_t x = firstDot - 1 + offset;
+        if(x > 255)
+        {
+            break;
+        }
+        
+        const bool bSpritePixel = offset <= shiftStart ? sprite.m_patternLatch != 0 : (spritePattern & (0x80 >> (offset - shiftStart - 1))) != 0;
+        if(!bSpritePixel || (x <= 7 && !(bBackgroundL8 && bSpriteL8)))
+        {
+            continue;
+        }
+        
+        const uint16_t stream = m_fineX + x;
+        const uint16_t slot = stream / 8;
+        
+        uint8_t opacity = 0;
+        if(slot < firstSlot + 2)
+        {
+            opacity = uint8_t(tileOpacity >> (slot == firstSlot ? 8 : 0));
+        }
+        else
+        {
+            // Tiles are only fetched forwards
+            while(fetchedSlot <= slot)
+            {
+                fetchedOpacity = TileOpacity(tileAddress);
+                tileAddress = IncrementTileAddress(tileAddress);
+                ++fetchedSlot;
+            }
+            opacity = fetchedOpacity;
+        }
+        
+        if(opacity & (0x80 >> (stream % 8)))
+        {
+            return x + 1;
+        }
+    }
+    
+    return 0;
+}
+
+uint8_t PPUNES::TileOpacity(uint16_t tileAddress) const
+{
+    // Both pattern planes of the tile row FetchBackgroundTile would load from this v
+    const uint16_t nametableAddress = 0x2000 + (tileAddress & 0x0FFF);
+    const uint8_t tileIndex = m_nametableMap[(nametableAddress >> 10) & 0b11][nametableAddress & 0x3FF];
+    
+    const uint16_t baseAddress = (m_ctrl & CTRL_BACKGROUND_TABLE_ADDR) ? 0x1000 : 0x0000;
+    const uint16_t patternAddress = baseAddress + (uint16_t(tileIndex) * 16) + ((tileAddress >> 12) & 7);
+    
+    return m_patternMap[patternAddress >> 10][patternAddress & 0x3FF] | m_patternMap[(patternAddress + 8) >> 10][(patternAddress + 8) & 0x3FF];
+}
+
+void PPUNES::ClearSecondaryOAM()
+{
+    if(m_scanlineDot >= 1 && m_scanlineDot <= 64)
+    {
+        if(m_scanlineDot == 64)
+        {
+            m_spriteZero = 0xFF;
+            memset(m_secondaryOAM, 0xFF, sizeof(m_secondaryOAM));
+        }
+    }
+}
+
+void PPUNES::SpriteEvaluation()
+{
+    // Odd data read even data write
+    if(m_scanlineDot >= 65 && m_scanlineDot <= 256)
+    {
+        if(m_scanlineDot % 2 == 0)
+        {
+            EvaluateSprite();
+        }
+    }
+}
+
+void PPUNES::EvaluateSprite()
+{
+    uint8_t spriteTop = m_primaryOAM[m_oamAddress];
+    uint8_t spriteBottom = spriteTop + (TestFlag(CTRL_SPRITE_SIZE, m_ctrl) ? 15 : 7);
+    
+    if(m_scanline >= spriteTop && m_scanline <= spriteBottom)
+    {
+        AddSecondarySprite();
+    }
+    
+    m_oamAddress += 4;
+}
+
+void PPUNES::AddSecondarySprite()
+{
+    if(m_secondaryOAMWrite < 32)
+    {
+        m_secondaryOAM[m_secondaryOAMWrite + 0] = m_primaryOAM[m_oamAddress + 0];
+        m_secondaryOAM[m_secondaryOAMWrite + 1] = m_primaryOAM[m_oamAddress + 1];
+        m_secondaryOAM[m_secondaryOAMWrite + 2] = m_primaryOAM[m_oamAddress + 2];
+        m_secondaryOAM[m_secondaryOAMWrite + 3] = m_primaryOAM[m_oamAddress + 3];
+        
+        m_secondaryOAMWrite += 4;
+        
+        if(m_oamAddress == 0)
+        {
+            m_spriteZero = 1;
+        }
+    }
+    else
+    {
+        SetFlag(STATUS_SPRITE_OVERFLOW, m_status);
+    }
+}
+
+void PPUNES::EvaluateSprites(uint16_t lastDot)
+{
+    // Every even dot from the first still to run scans one OAM entry - the registers can't change in between
+    uint32_t evaluationCount = lastDot / 2 - (m_spriteEvaluationDot - 1) / 2;
+    m_spriteEvaluationDot = lastDot < 256 ? lastDot + 1 : 0;
+    
+    if(!TestFlag(MASK_SPRITE_SHOW, m_mask))
+    {
+        return;
+    }
+    
+    // A misaligned OAMADDR compares bytes other than Y, the sprite masks don't cover that
+    if((m_oamAddress & 0x3) != 0)
+    {
+        for(uint32_t evaluation = 0;evaluation < evaluationCount;++evaluation)
+        {
+            EvaluateSprite();
+        }
+        return;
+    }
+    
+    const uint8_t spriteHeight = TestFlag(CTRL_SPRITE_SIZE, m_ctrl) ? 16 : 8;
+    if(m_spriteLinesHeight != spriteHeight)
+    {
+        m_spriteLinesHeight = spriteHeight;
+        UpdateSpriteLines();
+    }
+    
+    // At most 96 entries from OAMADDR, wrapping back around to sprite 0 as the dot loop does
+    const uint64_t lineSprites = m_spriteLines[m_scanline];
+    while(evaluationCount > 0)
+    {
+        const uint32_t firstSprite = m_oamAddress >> 2;
+        const uint32_t spriteCount = evaluationCount < 64 - firstSprite ? evaluationCount : 64 - firstSprite;
+        
+        uint64_t inRange = lineSprites >> firstSprite;
+        if(spriteCount < 64)
+        {
+            inRange &= (uint64_t(1) << spriteCount) - 1;
+        }
+        
+        const uint8_t baseAddress = m_oamAddress;
+        while(inRange != 0)
+        {
+            m_oamAddress = baseAddress + uint8_t(__builtin_ctzll(inRange) * 4);
+            AddSecondarySprite();
+            inRange &= inRange - 1;
+        }
+        
+        m_oamAddress = baseAddress + uint8_t(spriteCount * 4);
+        evaluationCount -= spriteCount;
+    }
+}
+
+void PPUNES::UpdateSpriteLines()
+{
+    memset(m_spriteLines, 0x00, sizeof(m_spriteLines));
+    
+    for(uint32_t sprite = 0;sprite < 64;++sprite)
+    {
+        // Same 8 bit compare as EvaluateSprite - a bottom past 255 wraps and never matches
+        const uint32_t spriteTop = m_primaryOAM[sprite * 4];
+        const uint32_t spriteBottom = spriteTop + m_spriteLinesHeight - 1;
+        if(spriteBottom > 255)
+        {
+            continue;
+        }
+        
+        const uint64_t spriteBit = uint64_t(1) << sprite;
+        for(uint32_t line = spriteTop;line <= spriteBottom && line < 240;++line)
+        {
+            m_spriteLines[line] |= spriteBit;
+        }
+    }
+}
+
+uint16_t PPUNES::SpriteLineAddress(uint16_t scanline, uint8_t yPos, uint8_t spriteTileId, uint8_t spriteAttribute) const
+{
+    bool bFlipV = (spriteAttribute & (1 << 7)) != 0;
+    
+    uint16_t spriteTileAddress = 0;
+    if((m_ctrl & CTRL_SPRITE_SIZE) != 0)
+    {
+        // 8 x 16 sprite size
+        
+        // LSB (i.e. odd/even) gives pattern table
+        uint16_t spriteBaseAddress = 0x0000;
+        if((spriteTileId & 1) != 0)
+        {
+            spriteBaseAddress = 0x1000;
+        }
+        
+        // Bottom is next tile, add 16 bytes
+        uint16_t top = spriteBaseAddress + (uint16_t(spriteTileId & 0b11111110) * 16);
+        uint16_t bottom = top + 16;
+        
+        // If its flipped then bottom becomes top
+        // Bit flipping is generic below for both 8 or 16 tall sprites
+        if(bFlipV)
+        {
+            uint16_t swap = bottom;
+            bottom = top;
+            top = swap;
+        }
+        
+        spriteTileAddress = top;
+        
+        // scanline is into the bottom part of the sprite
+        if(scanline - yPos > 7)
+        {
+            spriteTileAddress = bottom;
+            yPos += 8;
+        }
+    }
+    else
+    {
+        // 8 x 8 sprite size
+        uint16_t spriteBaseAddress = 0x0000;
+        if((m_ctrl & CTRL_SPRITE_TABLE_ADDR) != 0)
+        {
+            spriteBaseAddress = 0x1000;
         }
+        spriteTileAddress = spriteBaseAddress + (uint16_t(spriteTileId) * 16);
+    }
+    
+    uint16_t spriteLineAddress = spriteTileAddress + scanline - yPos;
+    
+    if(bFlipV)
+    {
+        spriteLineAddress = spriteTileAddress + (7 - (scanline - yPos));
     }
+    
+    return spriteLineAddress;
 }
 
 void PPUNES::SpriteFetch()
@@ -436,76 +1323,16 @@ void PPUNES::SpriteFetch()
                 uint8_t xPos            = m_secondaryOAM[spriteIndex * 4 + 3];
                 
                 bool bFlipH = (spriteAttribute & (1 << 6)) != 0;
-                bool bFlipV = (spriteAttribute & (1 << 7)) != 0;
-                
-                uint16_t spriteTileAddress = 0;
-                if(TestFlag(CTRL_SPRITE_SIZE, m_ctrl))
-                {
-                    // 8 x 16 sprite size
-                    
-                    // LSB (i.e. odd/even) gives pattern table
-                    uint16_t spriteBaseAddress = 0x0000;
-                    if((spriteTileId & 1) != 0)
-                    {
-                        spriteBaseAddress = 0x1000;
-                    }
-                    
-                    // Bottom is next tile, add 16 bytes
-                    uint16_t top = spriteBaseAddress + (uint16_t(spriteTileId & 0b11111110) * 16);
-                    uint16_t bottom = top + 16;
-                    
-                    // If its flipped then bottom becomes top
-                    // Bit flipping is generic below for both 8 or 16 tall sprites
-                    if(bFlipV)
-                    {
-                        uint16_t swap = bottom;
-                        bottom = top;
-                        top = swap;
-                    }
-                    
-                    spriteTileAddress = top;
-                    
-                    // scanline is into the bottom part of the sprite
-                    if(m_scanline - yPos > 7)
-                    {
-                        spriteTileAddress = bottom;
-                        yPos += 8;
-                    }
-                }
-                else
-                {
-                    // 8 x 8 sprite size
-                    uint16_t spriteBaseAddress = 0x0000;
-                    if(TestFlag(CTRL_SPRITE_TABLE_ADDR, m_ctrl))
-                    {
-                        spriteBaseAddress = 0x1000;
-                    }
-                    spriteTileAddress = spriteBaseAddress + (uint16_t(spriteTileId) * 16);
-                }
-                
-                uint16_t spriteLineAddress = spriteTileAddress + m_scanline - yPos;
                 
-                if(bFlipV)
-                {
-                    spriteLineAddress = spriteTileAddress + (7 - (m_scanline - yPos));
-                }
+                uint16_t spriteLineAddress = SpriteLineAddress(m_scanline, yPos, spriteTileId, spriteAttribute);
                 
                 uint8_t spritePlane0 = ppuReadAddress(spriteLineAddress);
                 uint8_t spritePlane1 = ppuReadAddress(spriteLineAddress + 8);
                 
                 if(bFlipH)
                 {
-                    auto flipBits = [&](uint8_t& byte)
-                    {
-                        uint8_t src = byte;
-                        byte = 0;
-                        for(uint8_t b = 0;b < 8;++b)
-                        {
-                            byte |= (((src & 1 << (7 - b))) ? 1 : 0) << b;
-                        }
-                    };
-                    flipBits(spritePlane0);
-                    flipBits(spritePlane1);
+                    spritePlane0 = kPatternDecode.m_reverse[spritePlane0];
+                    spritePlane1 = kPatternDecode.m_reverse[spritePlane1];
                 }
                 
                 sprite.m_patternLatch = 0;
@@ -559,30 +1386,33 @@ uint8_t PPUNES::ppuReadAddress(uint16_t address)
     
     if(address >= 0 && address <= 0x1FFF)
     {
-        // cart pattern table
-        data = m_bus.ppuRead(address);
+        // cart pattern table - mapped pages skip the bus
+        uint8_t* pPattern = m_patternMap[address >> 10];
+        if(pPattern != nullptr)
+        {
+            data = pPattern[address & 0x3FF];
+            
+            if(m_pPatternObserver != nullptr)
+            {
+                m_pPatternObserver->PPUBusRead(address);
+            }
+        }
+        else
+        {
+            data = m_bus.ppuRead(address);
+        }
     }
     else if(address >= 0x2000 && address <= 0x3EFF)
     {
         // name table mirrors
-        uint16_t vRamAddress = absoluteAddressToVRAMAddress(address);
-        if(m_mirrorMode == VRAM_MIRROR_CART4)
+        uint8_t* pNametable = m_nametableMap[(address >> 10) & 0b11];
+        if(pNametable != nullptr)
         {
-            data = m_bus.ppuRead(vRamAddress);
+            data = pNametable[address & 0x3FF];
         }
         else
         {
-            uint16_t vRamOffset = vRamAddress - 0x2000;
-            if(vRamOffset < sizeof(m_vram))
-            {
-                data = m_vram[vRamOffset];
-            }
-#if DEBUG
-            else
-            {
-                 *(volatile char*)(0) = 'V' | 'R' | 'A' | 'M';
-            }
-#endif
+            data = m_bus.ppuRead(address);
         }
     }
     else if(address >= 0x3F00 && address <= 0x3FFF)
@@ -611,24 +1441,14 @@ void PPUNES::ppuWriteAddress(uint16_t address, uint8_t byte)
     else if(address >= 0x2000 && address <= 0x3EFF)
     {
         // name table mirrors
-        uint16_t vRamAddress = absoluteAddressToVRAMAddress(address);
-        if(m_mirrorMode == VRAM_MIRROR_CART4)
+        uint8_t* pNametable = m_nametableMap[(address >> 10) & 0b11];
+        if(pNametable != nullptr)
         {
-            m_bus.ppuWrite(vRamAddress, byte);
+            pNametable[address & 0x3FF] = byte;
         }
         else
         {
-            uint16_t vRamOffset = vRamAddress - 0x2000;
-            if(vRamOffset < sizeof(m_vram))
-            {
-                m_vram[vRamOffset] = byte;
-            }
-#if DEBUG
-            else
-            {
-                 *(volatile char*)(0) = 'V' | 'R' | 'A' | 'M';
-            }
-#endif
+            m_bus.ppuWrite(address, byte);
         }
     }
     else if(address >= 0x3F00 && address <= 0x3FFF)
@@ -661,68 +1481,16 @@ void PPUNES::ppuWriteAddress(uint16_t address, uint8_t byte)
 // ||| ++-------------- nametable select
 // +++----------------- fine Y scroll
 
+
+
 void PPUNES::vramIncHorz()
 {
-    // break apart
-    uint16_t coarseX =      (m_ppuAddress >> 0) & 31;
-    uint16_t coarseY =      (m_ppuAddress >> 5) & 31;
-    uint16_t nametable =    (m_ppuAddress >> 10) & 3;
-    uint16_t fineY =        (m_ppuAddress >> 12) & 7;
-        
-    // update coarse for next tile fetch
-    if(coarseX < 31)
-    {
-        ++coarseX;
-    }
-    else
-    {
-        coarseX = 0;
-        nametable ^= 1;
-    }
-
-    // put back together
-    m_ppuAddress =  (coarseX & 31) << 0;
-    m_ppuAddress |= (coarseY & 31) << 5;
-    m_ppuAddress |= (nametable & 3) << 10;
-    m_ppuAddress |= (fineY & 7) << 12;
+    m_ppuAddress = IncrementTileAddress(m_ppuAddress);
 }
 
 void PPUNES::vramIncVert()
 {
-    // break apart
-    uint16_t coarseX =      (m_ppuAddress >> 0) & 31;
-    uint16_t coarseY =      (m_ppuAddress >> 5) & 31;
-    uint16_t nametable =    (m_ppuAddress >> 10) & 3;
-    uint16_t fineY =        (m_ppuAddress >> 12) & 7;
-    
-    // update coarse for next tile fetch
-    if(fineY < 7)
-    {
-        ++fineY;
-    }
-    else
-    {
-        fineY = 0;
-        if(coarseY == 29)
-        {
-            coarseY = 0;
-            nametable ^= 2;
-        }
-        else if(coarseY == 31)
-        {
-            coarseY = 0;
-        }
-        else
-        {
-            ++coarseY;
-        }
-    }
-    
-    // put back together
-    m_ppuAddress =  (coarseX & 31) << 0;
-    m_ppuAddress |= (coarseY & 31) << 5;
-    m_ppuAddress |= (nametable & 3) << 10;
-    m_ppuAddress |= (fineY & 7) << 12;
+    m_ppuAddress = IncrementLineAddress(m_ppuAddress);
 }
 
 void PPUNES::vramHorzCopy()
@@ -804,62 +1572,7 @@ void PPUNES::UpdateShiftRegisters()
             // Try doing all this at once, if it doesn't work then follow the vram fetch cycles
             if(vramFetchCycle == 0)
             {
-                uint16_t coarseX =      (m_ppuAddress >> 0) & 31;
-                uint16_t coarseY =      (m_ppuAddress >> 5) & 31;
-                //uint16_t nametable =    (m_ppuAddress >> 10) & 3;
-                uint16_t fineY =        (m_ppuAddress >> 12) & 7;
-
-                // load data into latches
-                // Pattern
-                {
-                    uint16_t nametableAddress = 0x2000 + (m_ppuAddress & 0x0FFF);
-                    uint8_t tileIndex = ppuReadAddress(nametableAddress);
-                    
-                    // Flag per frame or scanline, this is per tile line fetch?
-                    uint16_t baseAddress = TestFlag(CTRL_BACKGROUND_TABLE_ADDR, m_ctrl) ? 0x1000 : 0x0000;
-                    uint16_t tileAddress = baseAddress + (uint16_t(tileIndex) * 16);
-                                        
-                    uint16_t pattern0 = ppuReadAddress(tileAddress + fineY + 0);
-                    uint16_t pattern1 = ppuReadAddress(tileAddress + fineY + 8);
-                    
-                    // clear low bits and set next 8 bit pattern
-                    m_bgPatternShift0 &= 0xFF00;
-                    m_bgPatternShift1 &= 0xFF00;
-                    m_bgPatternShift0 |= pattern0;
-                    m_bgPatternShift1 |= pattern1;
-                }
-                
-                // Attribute
-                {
-                    uint16_t attributeAddress = 0x23C0 | (m_ppuAddress & 0x0C00) | ((m_ppuAddress >> 4) & 0x38) | ((m_ppuAddress >> 2) & 0x07);
-                    uint8_t tileAttribute = ppuReadAddress(attributeAddress);
-                    
-                    uint8_t attribQuadX = (coarseX / 2) % 2;
-                    uint8_t attribQuadY = (coarseY / 2) % 2;
-                    
-                    uint8_t attributeBits = 0;
-
-                    if(attribQuadX == 0 && attribQuadY == 0)
-                        attributeBits = (tileAttribute >> 0 ) & 0x3;
-                    else if(attribQuadX == 1 && attribQuadY == 0)
-                        attributeBits = (tileAttribute >> 2) & 0x3;
-                    else if(attribQuadX == 0 && attribQuadY == 1)
-                        attributeBits = (tileAttribute >> 4) & 0x3;
-                    else if(attribQuadX == 1 && attribQuadY == 1)
-                        attributeBits = (tileAttribute >> 6) & 0x3;
-#if DEBUG
-                    else
-                        *(volatile char*)(0) = 'P' | 'P' | 'U';
-#endif
-
-                    for(uint8_t i = 0;i < 8;++i)
-                    {
-                        m_bgPalletteShift0 |= ((attributeBits & 1) >> 0) << i;
-                        m_bgPalletteShift1 |= ((attributeBits & 2) >> 1) << i;
-                    }
-                }
-                
-                vramIncHorz();
+                FetchBackgroundTile();
             }
         }
 
@@ -879,6 +1592,66 @@ void PPUNES::UpdateShiftRegisters()
     }
 }
 
+void PPUNES::FetchBackgroundTile()
+{
+    uint16_t coarseX =      (m_ppuAddress >> 0) & 31;
+    uint16_t coarseY =      (m_ppuAddress >> 5) & 31;
+    //uint16_t nametable =    (m_ppuAddress >> 10) & 3;
+    uint16_t fineY =        (m_ppuAddress >> 12) & 7;
+
+    // load data into latches
+    // Pattern
+    {
+        uint16_t nametableAddress = 0x2000 + (m_ppuAddress & 0x0FFF);
+        uint8_t tileIndex = ppuReadAddress(nametableAddress);
+        
+        // Flag per frame or scanline, this is per tile line fetch?
+        uint16_t baseAddress = TestFlag(CTRL_BACKGROUND_TABLE_ADDR, m_ctrl) ? 0x1000 : 0x0000;
+        uint16_t tileAddress = baseAddress + (uint16_t(tileIndex) * 16);
+                            
+        uint16_t pattern0 = ppuReadAddress(tileAddress + fineY + 0);
+        uint16_t pattern1 = ppuReadAddress(tileAddress + fineY + 8);
+        
+        // clear low bits and set next 8 bit pattern
+        m_bgPatternShift0 &= 0xFF00;
+        m_bgPatternShift1 &= 0xFF00;
+        m_bgPatternShift0 |= pattern0;
+        m_bgPatternShift1 |= pattern1;
+    }
+    
+    // Attribute
+    {
+        uint16_t attributeAddress = 0x23C0 | (m_ppuAddress & 0x0C00) | ((m_ppuAddress >> 4) & 0x38) | ((m_ppuAddress >> 2) & 0x07);
+        uint8_t tileAttribute = ppuReadAddress(attributeAddress);
+        
+        uint8_t attribQuadX = (coarseX / 2) % 2;
+        uint8_t attribQuadY = (coarseY / 2) % 2;
+        
+        uint8_t attributeBits = 0;
+
+        if(attribQuadX == 0 && attribQuadY == 0)
+            attributeBits = (tileAttribute >> 0 ) & 0x3;
+        else if(attribQuadX == 1 && attribQuadY == 0)
+            attributeBits = (tileAttribute >> 2) & 0x3;
+        else if(attribQuadX == 0 && attribQuadY == 1)
+            attributeBits = (tileAttribute >> 4) & 0x3;
+        else if(attribQuadX == 1 && attribQuadY == 1)
+            attributeBits = (tileAttribute >> 6) & 0x3;
+#if DEBUG
+        else
+            *(volatile char*)(0) = 'P' | 'P' | 'U';
+#endif
+
+        for(uint8_t i = 0;i < 8;++i)
+        {
+            m_bgPalletteShift0 |= ((attributeBits & 1) >> 0) << i;
+            m_bgPalletteShift1 |= ((attributeBits & 2) >> 1) << i;
+        }
+    }
+    
+    vramIncHorz();
+}
+
 void PPUNES::GenerateVideoPixel()
 {
     uint8_t tilePalletteSelect = 0x00;
@@ -962,12 +1735,12 @@ void PPUNES::GenerateVideoPixel()
     
     uint8_t palletteIndex = m_pallette[finalPalletteSelect];
     
-    if(m_pVideoOutput != nullptr)
+    if(m_videoOutput.m_pData != nullptr)
     {
         uint16_t y = m_scanline;
         uint16_t x = m_scanlineDot - 1;
   
-        m_pVideoOutput[y * 256 + x] = GetPixelColour(palletteIndex);
+        VideoWriteColours(m_videoOutput, x, y, &palletteIndex, 1, m_mask >> 5);
 
         // Hide top and bottom 8 pixels - can hide a lot of glitches on multi scroll games - TODO make an option
 //        if(y < 8 || y > 230)
@@ -977,73 +1750,231 @@ void PPUNES::GenerateVideoPixel()
     }
 }
 
-uint16_t PPUNES::absoluteAddressToVRAMAddress(uint16_t address)
+bool PPUNES::CanBatchScanline() const
 {
-    if(address >= 0x3000 && address <= 0x3EFF)
+    // Background fetches must read plain memory with no side effects - mapper handlers and observers need them dot by dot
+    if(!(m_mask & MASK_BACKGROUND_SHOW) || m_pPatternObserver != nullptr)
     {
-        address -= 0x1000;
+        return false;
     }
     
-    if(address >= 0x2000 && address <= 0x2FFF)
+    for(uint32_t page = 0;page < 8;++page)
     {
-        if(m_mirrorMode == VRAM_MIRROR_H)
+        if(m_patternMap[page] == nullptr)
         {
-            if(address >= 0x2400 && address <= 0x27FF)
-            {
-                address -= 0x0400;
-            }
-            else if(address >= 0x2800 && address <= 0x2BFF)
-            {
-                address -= 0x0400;
-            }
-            else if(address >= 0x2C00 && address <= 0x2FFF)
-            {
-                address -= 0x0800;
-            }
+            return false;
         }
-        else if(m_mirrorMode == VRAM_MIRROR_V)
+    }
+    
+    for(uint32_t table = 0;table < 4;++table)
+    {
+        if(m_nametableMap[table] == nullptr)
         {
-            if(address >= 0x2800 && address <= 0x2FFF)
-            {
-                address -= 0x0800;
-            }
+            return false;
         }
-        else if(m_mirrorMode == VRAM_MIRROR_SINGLEA)
+    }
+    
+    return true;
+}
+
+void PPUNES::SyncScanline()
+{
+    if(m_scanlineBatchDot != 0 && m_scanlineDot > m_scanlineBatchDot)
+    {
+        RenderScanline(m_scanlineDot - 1);
+    }
+    
+    SyncSpriteEvaluation();
+}
+
+void PPUNES::SyncSpriteEvaluation()
+{
+    if(m_spriteEvaluationDot != 0 && m_scanlineDot > m_spriteEvaluationDot)
+    {
+        EvaluateSprites(m_scanlineDot - 1);
+    }
+}
+
+void PPUNES::CheckScanlineBatch()
+{
+    // After a change the rest of the line may have to be drawn dot by dot
+    if(m_scanlineBatchDot != 0 && !CanBatchScanline())
+    {
+        m_scanlineBatchDot = 0;
+    }
+}
+
+void PPUNES::RenderScanline(uint16_t lastDot)
+{
+    // Same result as GenerateVideoPixel + UpdateShiftRegisters for each dot from m_scanlineBatchDot to lastDot
+    const uint16_t firstDot = m_scanlineBatchDot;
+    const uint16_t dotCount = lastDot + 1 - firstDot;
+    
+    // Background - each tile row decoded once into a stream of (attribute << 2) | pattern pixels
+    // Pixel x comes from m_fineX + x, the tile in the high byte of the shift registers at dot 1 is tile 0
+    uint8_t backgroundStream[34 * 8];
+    {
+        // Two tiles are already in the shift registers, part way through the first
+        const uint16_t shifted = (firstDot - 1) % 8;
+        const uint16_t pattern0 = m_bgPatternShift0 >> shifted;
+        const uint16_t pattern1 = m_bgPatternShift1 >> shifted;
+        const uint16_t pallette0 = m_bgPalletteShift0 >> shifted;
+        const uint16_t pallette1 = m_bgPalletteShift1 >> shifted;
+        
+        uint8_t* pTiles = &backgroundStream[((firstDot - 1) / 8) * 8];
+        DecodePlanes(pTiles + 0, pattern0 >> 8, pattern1 >> 8, pallette0 >> 8, pallette1 >> 8);
+        DecodePlanes(pTiles + 8, pattern0 & 0xFF, pattern1 & 0xFF, pallette0 & 0xFF, pallette1 & 0xFF);
+    }
+    
+    // Shift registers only need bringing up to date at each fetch
+    uint16_t dot = firstDot;
+    while(dot <= lastDot)
+    {
+        const uint16_t fetchDot = (dot + 7) & ~uint16_t(7);
+        const uint16_t endDot = fetchDot < lastDot ? fetchDot : lastDot;
+        
+        const uint16_t shift = endDot + 1 - dot;
+        m_bgPatternShift0 <<= shift;
+        m_bgPatternShift1 <<= shift;
+        m_bgPalletteShift0 <<= shift;
+        m_bgPalletteShift1 <<= shift;
+        
+        if(endDot == fetchDot)
         {
-            if(address >= 0x2400 && address <= 0x27FF)
-            {
-                address -= 0x0400;
-            }
-            else if(address >= 0x2800 && address <= 0x2BFF)
-            {
-                address -= 0x0800;
-            }
-            else if(address >= 0x2C00 && address <= 0x2FFF)
-            {
-                address -= 0x0C00;
-            }
+            FetchBackgroundTile();
+            DecodePlanes(   &backgroundStream[(fetchDot / 8 + 1) * 8],
+                            m_bgPatternShift0 & 0xFF, m_bgPatternShift1 & 0xFF,
+                            m_bgPalletteShift0 & 0xFF, m_bgPalletteShift1 & 0xFF);
         }
-        else if(m_mirrorMode == VRAM_MIRROR_SINGLEB)
+        dot = endDot + 1;
+    }
+    
+    if(lastDot == 256)
+    {
+        vramIncVert();
+    }
+    
+    // Sprites - highest index first so the lowest non transparent sprite is left in each pixel
+    const uint8_t kSpriteBehind = 1 << 5;
+    const uint8_t kSpriteZero   = 1 << 6;
+    uint8_t spriteLine[256];
+    memset(&spriteLine[firstDot - 1], 0x00, dotCount);
+    for(int32_t spriteIndex = 7;spriteIndex >= 0;--spriteIndex)
+    {
+        ScanlineSprite& sprite = m_scanlineSprites[spriteIndex];
+        
+        uint8_t spriteSelect = (1 << 4) + ((sprite.m_attribute & 0x3) << 2);
+        spriteSelect |= (sprite.m_attribute & (1 << 5)) != 0 ? kSpriteBehind : 0;
+        spriteSelect |= sprite.m_spriteZero ? kSpriteZero : 0;
+        
+        uint8_t* pSpriteLine = &spriteLine[firstDot - 1];
+        
+        // The latch holds until the dot the counter reaches zero, then takes one pattern pixel per dot
+        const uint16_t shiftStart = sprite.m_counter > 0 ? sprite.m_counter - 1 : 0;
+        if(sprite.m_patternLatch != 0)
         {
-            if(address >= 0x2000 && address <= 0x23FF)
+            for(uint16_t offset = 0;offset <= shiftStart && offset < dotCount;++offset)
             {
-                address += 0x0400;
+                pSpriteLine[offset] = spriteSelect | sprite.m_patternLatch;
             }
-            else if(address >= 0x2800 && address <= 0x2BFF)
+        }
+        
+        uint8_t pixels[8];
+        DecodePlanes(pixels, sprite.m_patternShift0, sprite.m_patternShift1, 0, 0);
+        for(uint16_t pixel = 0;pixel < 8 && shiftStart + 1 + pixel < dotCount;++pixel)
+        {
+            if(pixels[pixel] != 0)
             {
-                address -= 0x0400;
+                pSpriteLine[shiftStart + 1 + pixel] = spriteSelect | pixels[pixel];
             }
-            else if(address >= 0x2C00 && address <= 0x2FFF)
+        }
+        
+        if(dotCount > shiftStart)
+        {
+            const uint16_t shiftCount = dotCount - shiftStart;
+            sprite.m_patternLatch = shiftCount <= 8 ? pixels[shiftCount - 1] : 0;
+            sprite.m_patternShift0 = shiftCount < 8 ? sprite.m_patternShift0 << shiftCount : 0;
+            sprite.m_patternShift1 = shiftCount < 8 ? sprite.m_patternShift1 << shiftCount : 0;
+        }
+        sprite.m_counter = sprite.m_counter > dotCount ? sprite.m_counter - dotCount : 0;
+    }
+    
+    // Multiplexer logic - palette colours for the run then converted together
+    uint8_t colourLine[256];
+    const bool bBackgroundL8 = TestFlag(MASK_BACKGROUND_L8, m_mask);
+    const bool bSpriteShow = TestFlag(MASK_SPRITE_SHOW, m_mask);
+    const bool bSpriteL8 = TestFlag(MASK_SPRITE_L8, m_mask);
+    for(uint16_t x = firstDot - 1;x < lastDot;++x)
+    {
+        uint8_t backgroundSelect = 0;
+        uint8_t spriteSelect = 0;
+        
+        if(bBackgroundL8 || x > 7)
+        {
+            backgroundSelect = backgroundStream[m_fineX + x];
+        }
+        
+        if(bSpriteShow && (bSpriteL8 || x > 7))
+        {
+            spriteSelect = spriteLine[x];
+            
+            if((spriteSelect & kSpriteZero) && (m_compatibiltyMode & CompatabilityModeFlag_SPRITE0))
             {
-                address -= 0x0800;
+                SetFlag(STATUS_SPRITE0_HIT, m_status);
             }
         }
-        else if(m_mirrorMode == VRAM_MIRROR_CART4)
+        
+        uint8_t finalPalletteSelect = 0x00;
+        if((backgroundSelect & 0x3) == 0 && spriteSelect != 0)
+        {
+            finalPalletteSelect = spriteSelect & 0x1F;
+        }
+        else if((backgroundSelect & 0x3) != 0 && spriteSelect == 0)
         {
-            // no mirroring - all exista via on cart ram
+            finalPalletteSelect = backgroundSelect;
+        }
+        else if((backgroundSelect & 0x3) != 0 && spriteSelect != 0)
+        {
+            if(spriteSelect & kSpriteZero)
+            {
+                SetFlag(STATUS_SPRITE0_HIT, m_status);
+            }
+            
+            finalPalletteSelect = (spriteSelect & kSpriteBehind) ? backgroundSelect : spriteSelect & 0x1F;
         }
+        
+        colourLine[x] = m_pallette[finalPalletteSelect];
+    }
+    
+    if(m_videoOutput.m_pData != nullptr)
+    {
+        VideoWriteColours(m_videoOutput, firstDot - 1, m_scanline, &colourLine[firstDot - 1], dotCount, m_mask >> 5);
+    }
+    
+    m_scanlineBatchDot = lastDot < 256 ? lastDot + 1 : 0;
+}
+
+void PPUNES::SyncStatusRead()
+{
+    // PPUSTATUS only sees batched dots through sprite 0 hit - polling it leaves them batched while the hit isn't among them
+    uint32_t hitTick = 0;
+    if( m_scanlineBatchDot != 0 && PredictSprite0Hit(m_scanline, hitTick) &&
+        hitTick >= uint32_t(m_scanline) * kDotsPerScanline + m_scanlineDot)
+    {
+        SyncSpriteEvaluation();
     }
-    return address;
+    else
+    {
+        SyncScanline();
+    }
+}
+
+bool PPUNES::StatusMatchesLastRead()
+{
+    SyncStatusRead();
+    
+    // The last read left the status bits in the port latch
+    return ((m_status ^ m_portLatch) & 0b11100000) == 0;
 }
 
 uint8_t PPUNES::cpuRead(uint16_t address)
@@ -1053,6 +1984,16 @@ uint8_t PPUNES::cpuRead(uint16_t address)
     // 8 port addresses from 0x2000 - 0x3FFF repeating every 8 bytes
     const uint16_t port = (address - PortRegister_BaseAddress) % PortRegister_Count;
     
+    // Batched dots before this read see the old state
+    if(port == PPUSTATUS)
+    {
+        SyncStatusRead();
+    }
+    else
+    {
+        SyncScanline();
+    }
+    
     switch(port)
     {
         case PPUCTRL:   // 2000
@@ -1108,6 +2049,8 @@ uint8_t PPUNES::cpuRead(uint16_t address)
 
 void PPUNES::cpuWrite(uint16_t address, uint8_t byte)
 {
+    SyncScanline();
+    
     m_portLatch = byte;
     
     // 8 port addresses from 0x2000 - 0x3FFF repeating every 8 bytes
@@ -1148,6 +2091,7 @@ void PPUNES::cpuWrite(uint16_t address, uint8_t byte)
         case OAMDATA:   // 2004
         {
             m_primaryOAM[m_oamAddress++] = byte;
+            m_spriteLinesHeight = 0;
             break;
         }
         case PPUSCROLL: // 2005
@@ -1194,21 +2138,19 @@ void PPUNES::cpuWrite(uint16_t address, uint8_t byte)
             break;
         }
     }
+    
+    CheckScanlineBatch();
 }
 
-uint32_t PPUNES::GetPixelColour(uint32_t palletteIndex)
+void PPUNES::WriteOAM(const uint8_t* pData)
 {
-    const uint8_t Pallette[] =
-    {
-         84,  84,  84,    0,  30, 116,    8,  16, 144,   48,   0, 136,   68,   0, 100,   92,   0,  48,   84,   4,   0,   60,  24,   0,   32,  42,   0,    8,  58,   0,    0,  64,   0,    0,  60,   0,    0,  50,  60,    0,   0,   0,    0, 0, 0,  0, 0, 0,
-        152, 150, 152,    8,  76, 196,   48,  50, 236,   92,  30, 228,  136,  20, 176,  160,  20, 100,  152,  34,  32,  120,  60,   0,   84,  90,   0,   40, 114,   0,    8, 124,   0,    0, 118,  40,    0, 102, 120,    0,   0,   0,    0, 0, 0,  0, 0, 0,
-        236, 238, 236,   76, 154, 236,  120, 124, 236,  176,  98, 236,  228,  84, 236,  236,  88, 180,  236, 106, 100,  212, 136,  32,  160, 170,   0,  116, 196,   0,   76, 208,  32,   56, 204, 108,   56, 180, 204,   60,  60,  60,    0, 0, 0,  0, 0, 0,
-        236, 238, 236,  168, 204, 236,  188, 188, 236,  212, 178, 236,  236, 174, 236,  236, 174, 212,  236, 180, 176,  228, 196, 144,  204, 210, 120,  180, 222, 120,  168, 226, 144,  152, 226, 180,  160, 214, 228,  160, 162, 160,    0, 0, 0,  0, 0, 0,
-    };
+    SyncScanline();
     
-    uint32_t r = Pallette[palletteIndex * 3 + 0];
-    uint32_t g = Pallette[palletteIndex * 3 + 1];
-    uint32_t b = Pallette[palletteIndex * 3 + 2];
+    // Same as 256 OAMDATA writes - wraps from OAMADDR and leaves it where it started
+    const uint32_t firstPart = 256 - m_oamAddress;
+    memcpy(&m_primaryOAM[m_oamAddress], pData, firstPart);
+    memcpy(&m_primaryOAM[0], pData + firstPart, 256 - firstPart);
     
-    return (0xFF << 24) + (r << 16) + (g << 8) + (b << 0);
+    m_portLatch = pData[255];
+    m_spriteLinesHeight = 0;
 }
@@ -10,6 +10,8 @@
 
 #include "IOBus.h"
 #include "Serialise.h"
+#include "EventQueue.h"
+#include "VideoOutput.h"
 
 // Workarounds for issues - i.e. failings in the emulation quality
 enum CompatabilityModeFlag
@@ -18,10 +20,21 @@ enum CompatabilityModeFlag
     CompatabilityModeFlag_SPRITE0   = 1 << 1,       // Flag sprite zero if drawn - ignore transparent logic vs bg
 };
 
-class PPUNES : public Serialisable
+class PPUNES : public Serialisable, public SystemEventHandler
 {
 public:
     SERIALISABLE_DECL
+    
+    enum PPU_EVENT : uint32_t
+    {
+        PPU_EVENT_NMI = 0                           // Delayed NMI signal in compatibility mode
+    };
+    
+    enum SPRITE_EVALUATION : uint8_t
+    {
+        SPRITE_EVALUATION_DOT = 0,                  // OAM scanned one sprite every other dot
+        SPRITE_EVALUATION_SCANLINE                  // Whole scanline at once from per scanline sprite masks, caught up on CPU access
+    };
 
     PPUNES(SystemIOBus& bus);
     ~PPUNES();
@@ -29,34 +42,99 @@ public:
     void SetMirrorMode(MirrorMode mode);
     MirrorMode GetMirrorMode() const;
     
+    // Cart pattern table pages read without going through the bus - see SystemIOBus::MapPPURead
+    void MapPatternMemory(uint16_t address, uint32_t size, uint8_t* pMemory);
+    void SetPatternObserver(PPUBusObserver* pObserver);
+    void SetCartVRAM(uint8_t* pCartVRAM);
+    void ResetCartMemory();
+    
     void PowerOn();
     void Reset();
     void Tick();
     
+    // Queue any pending events after power on or load
+    void ScheduleEvents();
+    virtual void SystemEvent(uint32_t eventID, uint64_t cycleCount) override;
+    
+    // PPU ticks to run so the next tick to set the vblank flag has just completed
+    uint32_t TicksUntilVBlank() const;
+    
+    // PPU ticks until the PPU could next change the NMI line
+    // bBusAccess - also stop at the next cart pattern/nametable fetch for mappers with PPU bus driven IRQs
+    uint32_t TicksUntilSignal(bool bBusAccess) const;
+    
+    // PPU ticks until the sprite 0 hit flag is set, exact while nothing writes to the PPU or changes cart memory
+    // Otherwise a lower bound - until the pre-render line with no hit this frame, 1 when it can't be predicted
+    uint32_t TicksUntilSprite0Hit() const;
+    
+    // PPU ticks until a PPUSTATUS read could see a different value - vblank, sprite 0 hit or overflow set, or the pre-render line clearing them
+    // Exact while nothing writes to the PPU or changes cart memory, 1 when it can't be predicted
+    uint32_t TicksUntilStatusChange();
+    
+    // PPUSTATUS would read back the same as the last read - brings batched dots up to date as the read would
+    bool StatusMatchesLastRead();
+    
+    // PPU ticks before sprite evaluation or fetches next read OAM or reset OAMADDR, 0 while they could
+    uint32_t TicksUntilOAMAccess() const;
+    
+    // All 256 bytes of an OAM DMA at once, only while nothing could see them arrive one at a time - see TicksUntilOAMAccess
+    void WriteOAM(const uint8_t* pData);
+    
     uint8_t cpuRead(uint16_t address);
     void cpuWrite(uint16_t address, uint8_t byte);
     
-    // Expects a 256x240 RGBA8 pixel foramt data pointer
+    // Expects a 256x240 BGRA8 pixel foramt data pointer with packed lines
     void SetVideoOutputDataPtr(uint32_t* pVideoOutData);
     
+    // 256x240 in any VideoFormat - the data pointer may be null for no output
+    void SetVideoOutput(const VideoOutputDesc& output);
+    
     // flag = 0, clears all current set flags
     void SetCompatabilityMode(uint8_t flag);
+    
+    // Output is identical either way, scanline is faster
+    void SetSpriteEvaluation(SPRITE_EVALUATION evaluation);
+    
+    // Draw any dots of a batched scanline the PPU has already ticked past
+    void SyncScanline();
 
 private:
+    
+    struct ScanlineSprite;
 
     void SetFlag(uint8_t flag, uint8_t& ppuRegister);
     void ClearFlag(uint8_t flag, uint8_t& ppuRegister);
     bool TestFlag(uint8_t flag, uint8_t& ppuRegister);
     
-    uint16_t absoluteAddressToVRAMAddress(uint16_t address);
-    uint32_t GetPixelColour(uint32_t palletteIndex);
+    uint32_t TicksUntilFrameTick(uint32_t frameTick) const;
+    uint32_t TicksUntilSpriteOverflow();
+    
+    void UpdateNametableMap();
     
     void UpdateShiftRegisters();
+    void FetchBackgroundTile();
     void ClearSecondaryOAM();
     void SpriteEvaluation();
+    void EvaluateSprite();
+    void AddSecondarySprite();
+    void EvaluateSprites(uint16_t lastDot);
+    void UpdateSpriteLines();
     void SpriteFetch();
+    uint16_t SpriteLineAddress(uint16_t scanline, uint8_t yPos, uint8_t spriteTileId, uint8_t spriteAttribute) const;
     void GenerateVideoPixel();
     
+    void SyncSpriteEvaluation();
+    void SyncStatusRead();
+    
+    bool PredictSprite0Hit(uint16_t lastScanline, uint32_t& frameTick) const;
+    bool PredictSprite0Slot(uint16_t scanline, uint8_t oamAddress, uint32_t evaluationCount, uint8_t secondaryOAMWrite, bool bSpriteZero, ScanlineSprite& sprite) const;
+    uint16_t Sprite0HitDot(const ScanlineSprite& sprite, uint16_t firstDot, uint16_t tileOpacity, uint16_t tileAddress) const;
+    uint8_t TileOpacity(uint16_t tileAddress) const;
+    
+    bool CanBatchScanline() const;
+    void CheckScanlineBatch();
+    void RenderScanline(uint16_t lastDot);
+    
     uint8_t ppuReadAddress(uint16_t address);
     void ppuWriteAddress(uint16_t address, uint8_t byte);
     
@@ -74,6 +152,14 @@ private:
     // Current VRAM mirroring
     MirrorMode m_mirrorMode;
     
+    // $2000, $2400, $2800, $2C00 nametables - rebuilt when the mirror mode changes
+    uint8_t* m_nametableMap[4];
+    uint8_t* m_pCartVRAM;
+    
+    // Cart pattern table 1KB pages - nullptr pages go through the bus
+    uint8_t* m_patternMap[8];
+    PPUBusObserver* m_pPatternObserver;
+    
     // Nametable + Pallette RAM
     uint8_t m_vram[2048];                           // 2x 1024 byte name tables - last 64 bytes of each are the attribute tables
     uint8_t m_pallette[32];
@@ -84,6 +170,11 @@ private:
     uint8_t m_secondaryOAMWrite;
     uint8_t m_spriteZero;
     
+    // Sprites in range of each visible scanline, bit n for OAM sprite n - rebuilt after OAM or sprite size changes
+    uint64_t m_spriteLines[240];
+    uint8_t m_spriteLinesHeight;                    // 0 when out of date
+    SPRITE_EVALUATION m_spriteEvaluation;
+    
     // Registers - CPU accessible
     uint8_t m_ctrl;
     uint8_t m_mask;
@@ -119,10 +210,12 @@ private:
     // Emulation
     uint16_t m_scanline;
     uint16_t m_scanlineDot;
-    uint16_t m_nmiSurpress;
+    uint16_t m_scanlineBatchDot;                    // next dot of a batched scanline still to draw, 0 when drawing dot by dot
+    uint16_t m_spriteEvaluationDot;                 // next dot of a scanline evaluation still to run, 0 when evaluating dot by dot
+    uint64_t m_nmiSignalCycle;                      // 0 if no delayed NMI pending
     
-    // Output
-    uint32_t* m_pVideoOutput;
+    // Output - stride always resolved
+    VideoOutputDesc m_videoOutput;
 };
 
 #endif /* PPUNES_h */
@@ -10,6 +10,8 @@
 
 #ifdef __cplusplus
     #include <cstdint>
+    #include <cstdio>
+    #include <cstring>
     #include <string>
 #endif
 
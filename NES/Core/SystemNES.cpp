@@ -11,9 +11,14 @@
 
 #include "Serialise.h"
 
+// Longest cycle stepped instruction is 7 CPU ticks, the last one 6 CPU ticks after the first
+const uint64_t kMaxInstructionCycles = 6 * 3;
+
 SystemNES::SystemNES()
 : m_bPowerOn(false)
 , m_cycleCount(0)
+, m_runEndCycle(0)
+, m_runLimitCycle(0)
 , m_cpu(*this)
 , m_ppu(*this)
 , m_apu(*this)
@@ -24,8 +29,19 @@ SystemNES::SystemNES()
 , m_controllerLatch2(0)
 , m_dmaAddress(0xFFFF)
 , m_dmaMode(DMA_OFF)
+, m_dmaTicksRemaining(0)
+, m_ppuSchedule(PPU_SCHEDULE_CATCHUP)
+, m_ppuCycleCount(0)
+, m_ppuSyncCycle(0)
+, m_apuSyncCycle(0)
+, m_cpuSchedule(CPU_SCHEDULE_INSTRUCTION)
+, m_cpuTicksAhead(0)
+, m_bIdleLoopSkip(true)
+, m_idleLoopSkippedTicks(0)
+, m_idleLoopStatsCycle(0)
 {
     memset(m_ram, 0x00, sizeof(m_ram));
+    ResetMemoryMaps();
 }
 
 SystemNES::~SystemNES()
@@ -48,8 +64,10 @@ void SystemNES::Load(Archive& rArchive)
         {
             if(m_pCart != nullptr )
             {
+                m_events.Clear();
                 delete m_pCart;
                 m_pCart = nullptr;
+                ResetMemoryMaps();
             }
             m_pCart = new Cartridge(*this, rArchive);
         }
@@ -65,14 +83,33 @@ void SystemNES::Load(Archive& rArchive)
     rArchive >> m_dmaAddress;
     rArchive >> m_dmaData;
     rArchive >> m_dmaMode;
+    rArchive >> m_dmaTicksRemaining;
     
     m_cpu.Load(rArchive);
     m_ppu.Load(rArchive);
     m_apu.Load(rArchive);
+    
+    // Saved state is always in step
+    m_ppuCycleCount = m_cycleCount;
+    m_ppuSyncCycle = m_cycleCount;
+    m_cpuTicksAhead = 0;
+    
+    m_idleLoopSkippedTicks = 0;
+    m_idleLoopStatsCycle = m_cycleCount;
+    
+    ScheduleEvents();
 }
 
 void SystemNES::Save(Archive& rArchive) const
 {
+#if DEBUG
+    // Whole instructions always finish inside RunCycles
+    if(m_cpuTicksAhead != 0)
+    {
+        *(volatile char*)(0) = 'C';
+    }
+#endif
+    
     if(m_pCart != nullptr)
     {
         rArchive << kArchiveSentinelHasData;
@@ -93,6 +130,7 @@ void SystemNES::Save(Archive& rArchive) const
     rArchive << m_dmaAddress;
     rArchive << m_dmaData;
     rArchive << m_dmaMode;
+    rArchive << m_dmaTicksRemaining;
     
     m_cpu.Save(rArchive);
     m_ppu.Save(rArchive);
@@ -105,8 +143,14 @@ void SystemNES::PowerOn()
     m_cpu.Reset();
 
     m_cycleCount = 0;
+    m_ppuCycleCount = 0;
+    m_ppuSyncCycle = 0;
+    m_cpuTicksAhead = 0;
+    m_idleLoopSkippedTicks = 0;
+    m_idleLoopStatsCycle = 0;
     m_dmaAddress = 0xFFFF;
     m_dmaMode = DMA_OFF;
+    m_dmaTicksRemaining = 0;
     
     m_ppu.PowerOn();
     m_cpu.PowerOn();
@@ -118,6 +162,8 @@ void SystemNES::PowerOn()
     
     memset(m_ram, 0x00, sizeof(m_ram));
     
+    ScheduleEvents();
+    
     m_bPowerOn = true;
 }
 
@@ -129,12 +175,15 @@ void SystemNES::Reset()
 void SystemNES::EjectCartridge()
 {
     m_bPowerOn = false;
+    m_events.Clear();
     
     if(m_pCart != nullptr)
     {
         delete m_pCart;
         m_pCart = nullptr;
     }
+    
+    ResetMemoryMaps();
 }
 
 bool SystemNES::InsertCartridge(const char* pCartPath)
@@ -195,6 +244,166 @@ void SystemNES::SetMirrorMode(MirrorMode mode)
     }
 }
 
+uint64_t SystemNES::GetPPUCycleCount()
+{
+    return m_ppuCycleCount;
+}
+
+uint64_t SystemNES::GetCycleCount()
+{
+    return m_cycleCount;
+}
+
+void SystemNES::ScheduleEvent(SystemEventHandler* pHandler, uint32_t eventID, uint64_t cycleCount)
+{
+#if DEBUG
+    // Events have to be in the future
+    if(cycleCount <= m_cycleCount)
+    {
+        *(volatile char*)(0) = 'E';
+    }
+#endif
+    
+    m_events.Schedule(pHandler, eventID, cycleCount);
+    
+    // Cut the current run short so the event is dispatched on time
+    if(cycleCount <= m_runEndCycle)
+    {
+        m_runEndCycle = cycleCount - 1;
+    }
+}
+
+void SystemNES::CancelEvent(SystemEventHandler* pHandler, uint32_t eventID)
+{
+    m_events.Cancel(pHandler, eventID);
+}
+
+bool SystemNES::cpuPlainMemoryPage(uint8_t page, bool bWrite)
+{
+    // Internal RAM and mirrors
+    if(page < 0x20)
+    {
+        return true;
+    }
+    
+    // Cart PRG RAM/ROM reads - mapper registers are all written
+    if(page >= 0x60 && !bWrite)
+    {
+        return m_pCart != nullptr;
+    }
+    
+    return false;
+}
+
+bool SystemNES::cpuStatusRegister(uint16_t address)
+{
+    // PPUSTATUS and its mirrors, SND_CHN
+    return (address >= 0x2000 && address <= 0x3FFF && (address & 0x7) == 0x2) || address == 0x4015;
+}
+
+void SystemNES::MapCPURead(uint16_t address, uint32_t size, uint8_t* pMemory)
+{
+    MapCPUPages(m_cpuReadMap, address, size, pMemory);
+}
+
+void SystemNES::MapCPUWrite(uint16_t address, uint32_t size, uint8_t* pMemory)
+{
+    MapCPUPages(m_cpuWriteMap, address, size, pMemory);
+}
+
+void SystemNES::MapPPURead(uint16_t address, uint32_t size, uint8_t* pMemory)
+{
+    m_ppu.MapPatternMemory(address, size, pMemory);
+}
+
+void SystemNES::SetPPUBusObserver(PPUBusObserver* pObserver)
+{
+    m_ppu.SetPatternObserver(pObserver);
+}
+
+void SystemNES::SetCartVRAM(uint8_t* pCartVRAM)
+{
+    m_ppu.SetCartVRAM(pCartVRAM);
+}
+
+void SystemNES::MapCPUPages(uint8_t** pPageMap, uint16_t address, uint32_t size, uint8_t* pMemory)
+{
+#if DEBUG
+    // Only whole pages can be mapped
+    if((address & 0xFF) != 0 || (size & 0xFF) != 0 || uint32_t(address) + size > 0x10000)
+    {
+        *(volatile char*)(0) = 'M' | 'A' | 'P';
+    }
+#endif
+    
+    uint32_t firstPage = address >> 8;
+    uint32_t pageCount = size >> 8;
+    for(uint32_t page = 0;page < pageCount;++page)
+    {
+        pPageMap[firstPage + page] = pMemory != nullptr ? pMemory + page * 256 : nullptr;
+    }
+}
+
+void SystemNES::ResetMemoryMaps()
+{
+    memset(m_cpuReadMap, 0x00, sizeof(m_cpuReadMap));
+    memset(m_cpuWriteMap, 0x00, sizeof(m_cpuWriteMap));
+    m_ppu.ResetCartMemory();
+    
+    // Internal RAM with mirrors every 2KB (0x0800 bytes)
+    for(uint16_t mirror = 0x0000;mirror < 0x2000;mirror += 0x0800)
+    {
+        MapCPURead(mirror, sizeof(m_ram), m_ram);
+        MapCPUWrite(mirror, sizeof(m_ram), m_ram);
+    }
+}
+
+void SystemNES::ScheduleEvents()
+{
+    // Pending events are rebuilt from component state rather than serialised
+    m_events.Clear();
+    
+    m_ppu.ScheduleEvents();
+    m_apu.ScheduleEvents();
+    if(m_pCart != nullptr)
+    {
+        m_pCart->ScheduleEvents();
+    }
+    
+    m_apuSyncCycle = m_apu.NextSyncCycle();
+}
+
+void SystemNES::SetPPUSchedule(PPU_SCHEDULE schedule)
+{
+    SyncPPU();
+    m_ppuSchedule = schedule;
+    UpdatePPUSyncCycle();
+}
+
+void SystemNES::SetCPUSchedule(CPU_SCHEDULE schedule)
+{
+    m_cpuSchedule = schedule;
+}
+
+void SystemNES::SetSpriteEvaluation(PPUNES::SPRITE_EVALUATION evaluation)
+{
+    m_ppu.SetSpriteEvaluation(evaluation);
+}
+
+void SystemNES::SetIdleLoopSkip(bool bSkip)
+{
+    m_bIdleLoopSkip = bSkip;
+}
+
+SystemNES::IdleLoopStats SystemNES::GetIdleLoopStats() const
+{
+    IdleLoopStats stats;
+    stats.m_cpuTicks = (m_cycleCount - m_idleLoopStatsCycle) / 3;
+    stats.m_skippedTicks = m_idleLoopSkippedTicks;
+    stats.m_skippedPercent = stats.m_cpuTicks > 0 ? float(double(stats.m_skippedTicks) * 100.0 / double(stats.m_cpuTicks)) : 0.f;
+    return stats;
+}
+
 void SystemNES::SetControllerBits(uint8_t port, uint8_t bits)
 {
     if(port == 0)
@@ -217,55 +426,335 @@ void SystemNES::Tick()
     // 2 CPU ticks to 1 APU tick - but ticking at same rate due to its internal requirements
     if(m_bPowerOn)
     {
-        ++m_cycleCount;
+        m_events.Dispatch(m_cycleCount + 1);
         
-        // Bus to cart
-        if(m_pCart != nullptr)
+        if(((m_cycleCount + 1) % 3) == 0)
         {
-            m_pCart->SystemTick(m_cycleCount);
+            TickCPUPhase();
         }
+        else
+        {
+            TickPPUPhase();
+        }
+        
+        // Single stepping keeps everything in step
+        SyncPPU();
+        m_ppu.SyncScanline();
+        SyncAPU();
+    }
+}
+
+void SystemNES::RunCycles(uint64_t cycleCount)
+{
+    if(!m_bPowerOn)
+    {
+        return;
+    }
     
-        // Graphics
+    const uint64_t endCycle = m_cycleCount + cycleCount;
+    m_runLimitCycle = endCycle;
+    
+    while(m_cycleCount < endCycle)
+    {
+        // Anything due on the next tick
+        m_events.Dispatch(m_cycleCount + 1);
+        
+        // Then nothing to check until the tick before the next event
+        m_runEndCycle = m_events.NextEventCycle() - 1;
+        if(m_runEndCycle > endCycle)
         {
-            m_ppu.Tick();
+            m_runEndCycle = endCycle;
         }
         
-        // CPU
-        if((m_cycleCount % 3) == 0 && m_dmaMode == DMA_OFF)
+        RunToCycle();
+    }
+    
+    // Bring the PPU and APU up to date so the video and audio output and any saved state are complete
+    SyncPPU();
+    m_ppu.SyncScanline();
+    SyncAPU();
+    m_apu.FilterAudio();
+}
+
+void SystemNES::RunFrame()
+{
+    RunCycles(m_ppu.TicksUntilVBlank());
+}
+
+inline void SystemNES::RunToCycle()
+{
+    // m_runEndCycle can be pulled in by anything scheduling an event while running
+    // Step until the last tick was a CPU tick
+    while(m_cycleCount < m_runEndCycle && (m_cycleCount % 3) != 0)
+    {
+        if(((m_cycleCount + 1) % 3) == 0)
+        {
+            TickCPUPhase();
+        }
+        else
         {
-            m_cpu.Tick();
+            TickPPUPhase();
         }
+    }
+    
+    // PPU, PPU, PPU + CPU - only the CPU phase schedules events due within a few ticks
+    while(m_cycleCount + 3 <= m_runEndCycle)
+    {
+        TickPPUPhase();
+        TickPPUPhase();
+        TickCPUPhase();
+    }
+    
+    // Any left over are PPU only ticks
+    while(m_cycleCount < m_runEndCycle)
+    {
+        TickPPUPhase();
+    }
+}
+
+inline void SystemNES::TickPPUPhase()
+{
+    ++m_cycleCount;
+    
+    // Bus to cart
+    if(m_pCart != nullptr)
+    {
+        m_pCart->SystemTick(m_cycleCount);
+    }
+    
+    // Graphics
+    if(m_ppuSchedule == PPU_SCHEDULE_LOCKSTEP)
+    {
+        TickPPU();
+    }
+}
+
+inline void SystemNES::TickCPUPhase()
+{
+    ++m_cycleCount;
+    
+    // Bus to cart
+    if(m_pCart != nullptr)
+    {
+        m_pCart->SystemTick(m_cycleCount);
+    }
+    
+    // Graphics
+    if(m_ppuSchedule == PPU_SCHEDULE_LOCKSTEP)
+    {
+        TickPPU();
+    }
+    else if(m_cycleCount >= m_ppuSyncCycle)
+    {
+        // PPU could change the NMI/IRQ lines before this CPU tick
+        SyncPPU();
+    }
+    
+    // CPU - halted while DMA has the bus
+    if(m_dmaMode == DMA_OFF)
+    {
+        TickCPU();
+    }
+    else
+    {
+        TickDMA();
+    }
+    
+    // Audio - otherwise only caught up on access and its own events
+    if(m_cycleCount >= m_apuSyncCycle)
+    {
+        SyncAPU();
+    }
+}
+
+inline void SystemNES::TickCPU()
+{
+    if(m_cpuTicksAhead > 0)
+    {
+        // Already run as part of a whole instruction
+        --m_cpuTicksAhead;
+    }
+    else if(m_cpuSchedule == CPU_SCHEDULE_INSTRUCTION && m_cycleCount + kMaxInstructionCycles <= m_runLimitCycle)
+    {
+        m_cpuTicksAhead = m_cpu.TickInstruction() - 1;
         
-        // Audio
-        if((m_cycleCount % 3) == 0)
+        // Just jumped back to the start of a loop that can only wait
+        if(m_bIdleLoopSkip && m_cpu.IdleLoopTicks() != 0)
         {
-            m_apu.Tick();
+            SkipIdleLoop();
         }
+    }
+    else
+    {
+        m_cpu.Tick();
+    }
+}
+
+void SystemNES::SkipIdleLoop()
+{
+    // Each time round is the same until the first cycle something the loop can see could change
+    const uint64_t iterationCycles = uint64_t(m_cpu.IdleLoopTicks()) * 3;
+    const uint64_t endCycle = IdleLoopEndCycle(m_cpu.IdleLoopStatusAddress());
+    
+    // Next time round starts on the CPU tick after the jump back, whole iterations have to run before endCycle
+    const uint64_t startCycle = m_cycleCount + (uint64_t(m_cpuTicksAhead) + 1) * 3;
+    const uint64_t lastTickCycle = endCycle - 1;
+    uint32_t iterationCount = 0;
+    if(lastTickCycle + 3 > startCycle)
+    {
+        iterationCount = uint32_t((lastTickCycle + 3 - startCycle) / iterationCycles);
+    }
+    
+    // The run loop still steps every skipped cycle - the cart and PPU tick through them and the APU catches up
+    // at its next sync cycle as usual, only the CPU instruction stepping is elided
+    const uint32_t skippedTicks = iterationCount * m_cpu.IdleLoopTicks();
+    m_cpu.SkipIdleLoop(iterationCount);
+    m_cpuTicksAhead += skippedTicks;
+    m_idleLoopSkippedTicks += skippedTicks;
+}
 
-        // DMA handling
-        if(m_dmaMode != DMA_OFF)
+uint64_t SystemNES::IdleLoopEndCycle(uint16_t statusAddress)
+{
+    // Events and the end of the run
+    uint64_t endCycle = m_runEndCycle + 1;
+    if(m_runLimitCycle + 1 < endCycle)
+    {
+        endCycle = m_runLimitCycle + 1;
+    }
+    
+    // IRQs raised on any tick rather than from an event - the APU only raises them from its events
+    if(m_pCart != nullptr && m_pCart->TickSignalsIRQ())
+    {
+        return m_cycleCount;
+    }
+    
+    // PPU changing the NMI/IRQ lines
+    SyncPPU();
+    const bool bBusAccess = m_pCart != nullptr && m_pCart->PPUBusSignalsIRQ();
+    const uint64_t signalCycle = m_ppuCycleCount + m_ppu.TicksUntilSignal(bBusAccess);
+    if(signalCycle < endCycle)
+    {
+        endCycle = signalCycle;
+    }
+    
+    // The status register must still read as it did last time round, then stay that way
+    if(statusAddress >= 0x2000 && statusAddress <= 0x3FFF)
+    {
+        if(!m_ppu.StatusMatchesLastRead())
         {
-            if(m_dmaMode == DMA_READ)
-            {
-                m_dmaData = this->cpuRead(m_dmaAddress);
-                m_dmaMode = DMA_WRITE;
-            }
-            else if(m_dmaMode == DMA_WRITE)
-            {
-                m_ppu.cpuWrite(0x2004, m_dmaData);
-                
-                if((m_dmaAddress & 0xFF) != 0xFF)
-                {
-                    m_dmaMode = DMA_READ;
-                    ++m_dmaAddress;
-                }
-                else
-                {
-                    m_dmaMode = DMA_OFF;
-                }
-            }
+            return m_cycleCount;
+        }
+        
+        const uint64_t statusCycle = m_ppuCycleCount + m_ppu.TicksUntilStatusChange();
+        if(statusCycle < endCycle)
+        {
+            endCycle = statusCycle;
         }
     }
+    else if(statusAddress != 0 && !m_apu.StatusMatchesLastRead())
+    {
+        return m_cycleCount;
+    }
+    
+    return endCycle;
+}
+
+void SystemNES::StartDMA(uint8_t page)
+{
+    // The CPU halts for a cycle then another if the first read would land on an odd cycle
+    // After that a read and a write every other cycle - 513 or 514 cycles in all
+    const uint8_t haltTicks = uint8_t(1 + ((m_cycleCount / 3) & 1));
+    const uint32_t stallTicks = haltTicks + 512;
+    
+    // Plain memory reads the same whenever it is read, the PPU has to be left alone with OAM until the CPU runs again
+    const uint8_t* pPage = m_cpuReadMap[page];
+    SyncPPU();
+    m_dmaAddress = uint16_t(page) << 8;
+    if(pPage != nullptr && m_ppu.TicksUntilOAMAccess() >= stallTicks * 3)
+    {
+        m_ppu.WriteOAM(pPage);
+        m_dmaTicksRemaining = uint16_t(stallTicks);
+        m_dmaMode = DMA_STALL;
+    }
+    else
+    {
+        m_dmaTicksRemaining = haltTicks;
+        m_dmaMode = DMA_HALT;
+    }
+}
+
+inline void SystemNES::TickDMA()
+{
+    if(m_dmaMode == DMA_READ)
+    {
+        m_dmaData = this->cpuRead(m_dmaAddress);
+        m_dmaMode = DMA_WRITE;
+    }
+    else if(m_dmaMode == DMA_WRITE)
+    {
+        SyncPPU();
+        m_ppu.cpuWrite(0x2004, m_dmaData);
+        
+        if((m_dmaAddress & 0xFF) != 0xFF)
+        {
+            m_dmaMode = DMA_READ;
+            ++m_dmaAddress;
+        }
+        else
+        {
+            m_dmaMode = DMA_OFF;
+        }
+    }
+    else if(m_dmaMode == DMA_HALT)
+    {
+        if(--m_dmaTicksRemaining == 0)
+        {
+            m_dmaMode = DMA_READ;
+        }
+    }
+    else if(m_dmaMode == DMA_STALL)
+    {
+        if(--m_dmaTicksRemaining == 0)
+        {
+            m_dmaMode = DMA_OFF;
+        }
+    }
+}
+
+inline void SystemNES::TickPPU()
+{
+    ++m_ppuCycleCount;
+    m_ppu.Tick();
+}
+
+void SystemNES::SyncPPU()
+{
+    if(m_ppuCycleCount < m_cycleCount)
+    {
+        while(m_ppuCycleCount < m_cycleCount)
+        {
+            TickPPU();
+        }
+        
+        UpdatePPUSyncCycle();
+    }
+}
+
+void SystemNES::SyncAPU()
+{
+    // Every APU tick up to and including this cycle
+    m_apu.Sync(m_cycleCount + 1);
+    m_apuSyncCycle = m_apu.NextSyncCycle();
+}
+
+void SystemNES::UpdatePPUSyncCycle()
+{
+    if(m_ppuSchedule == PPU_SCHEDULE_CATCHUP)
+    {
+        // Mappers like MMC3 raise IRQs from PPU fetches, they need the PPU to stay close while armed
+        const bool bBusAccess = m_pCart != nullptr && m_pCart->PPUBusSignalsIRQ();
+        m_ppuSyncCycle = m_ppuCycleCount + m_ppu.TicksUntilSignal(bBusAccess);
+    }
 }
 
 float SystemNES::AudioOut()
@@ -277,16 +766,23 @@ float SystemNES::AudioOut()
     return 0.f;
 }
 
+bool SystemNES::HasAudioOut()
+{
+    return m_pCart != nullptr && m_pCart->HasAudioOut();
+}
+
 uint8_t SystemNES::cpuRead(uint16_t address)
 {
-    if(address >= 0x0000 && address <= 0x1FFF)
+    // RAM and mapped cart memory
+    uint8_t* pPage = m_cpuReadMap[address >> 8];
+    if(pPage != nullptr)
     {
-        // ram with mirrors every 2KB (0x0800 bytes)
-        uint16_t memAddress = address % 0x0800;
-        return m_ram[memAddress];
+        return pPage[address & 0xFF];
     }
-    else if(address >= 0x2000 && address <= 0x3FFF)
+    
+    if(address >= 0x2000 && address <= 0x3FFF)
     {
+        SyncPPU();
         return m_ppu.cpuRead(address);
     }
     else if(address >= 0x4000 && address <= 0x401F)
@@ -308,7 +804,8 @@ uint8_t SystemNES::cpuRead(uint16_t address)
         }
         else
         {
-            // APU registers
+            // APU registers - the APU ticks after the CPU on the same cycle
+            m_apu.Sync(m_cycleCount);
             return m_apu.cpuRead(address);
         }
     }
@@ -324,14 +821,17 @@ uint8_t SystemNES::cpuRead(uint16_t address)
 
 void SystemNES::cpuWrite(uint16_t address, uint8_t byte)
 {
-    if(address >= 0x0000 && address <= 0x1FFF)
+    // RAM and mapped cart memory
+    uint8_t* pPage = m_cpuWriteMap[address >> 8];
+    if(pPage != nullptr)
     {
-        uint16_t memAddress = address % 0x0800;
-        m_ram[memAddress] = byte;
+        pPage[address & 0xFF] = byte;
     }
     else if(address >= 0x2000 && address <= 0x3FFF)
     {
+        SyncPPU();
         m_ppu.cpuWrite(address, byte);
+        UpdatePPUSyncCycle();
     }
     else if(address >= 0x4000 && address <= 0x401F)
     {
@@ -339,8 +839,7 @@ void SystemNES::cpuWrite(uint16_t address, uint8_t byte)
         {
             // Writing value XX (high byte) to 0x4014 will upload 256 bytes of data from
             // 0xXX00 - 0xXXFF at PPU address OAMADDR
-            m_dmaAddress = uint16_t(byte) << 8;
-            m_dmaMode = DMA_READ;
+            StartDMA(byte);
         }
         else if(address == 0x4016)
         {
@@ -352,12 +851,16 @@ void SystemNES::cpuWrite(uint16_t address, uint8_t byte)
         }
         else
         {
+            m_apu.Sync(m_cycleCount);
             m_apu.cpuWrite(address, byte);
         }
     }
     else if(address >= 0x4020 && address <= 0xFFFF && m_pCart != nullptr)
     {
+        // Mapper registers can switch CHR banks, mirroring and IRQ state the PPU depends on
+        SyncPPU();
         m_pCart->cpuWrite(address, byte);
+        UpdatePPUSyncCycle();
     }
 }
 
@@ -384,7 +887,49 @@ void SystemNES::SetVideoOutputDataPtr(uint32_t* pVideoOutData)
     m_ppu.SetVideoOutputDataPtr(pVideoOutData);
 }
 
+void SystemNES::SetVideoOutput(const VideoOutputDesc& output)
+{
+    m_ppu.SetVideoOutput(output);
+}
+
 void SystemNES::SetAudioOutputBuffer(APUAudioBuffer* pAudioBuffer)
 {
+    // Samples so far belong to the last buffer
+    if(m_bPowerOn)
+    {
+        SyncAPU();
+    }
     m_apu.SetAudioOutputBuffer(pAudioBuffer);
+    m_apuSyncCycle = m_apu.NextSyncCycle();
+}
+
+void SystemNES::BeginAudioFrame()
+{
+    // Samples so far belong to the last frame
+    if(m_bPowerOn)
+    {
+        SyncAPU();
+    }
+    m_apu.BeginAudioFrame();
+    m_apuSyncCycle = m_apu.NextSyncCycle();
+}
+
+void SystemNES::SetAudioStemBuffer(APUStemBuffer* pStemBuffer)
+{
+    // Samples so far belong to the last buffer
+    if(m_bPowerOn)
+    {
+        SyncAPU();
+    }
+    m_apu.SetAudioStemBuffer(pStemBuffer);
+}
+
+void SystemNES::SetAudioSampleRate(double sampleRate)
+{
+    if(m_bPowerOn)
+    {
+        SyncAPU();
+    }
+    m_apu.SetAudioSampleRate(sampleRate);
+    m_apuSyncCycle = m_apu.NextSyncCycle();
 }
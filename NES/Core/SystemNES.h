@@ -10,6 +10,7 @@
 
 #include "IOBus.h"
 #include "Serialise.h"
+#include "EventQueue.h"
 #include "CPU6502.h"
 #include "PPUNES.h"
 #include "APUNES.h"
@@ -25,7 +26,28 @@ public:
     {
         DMA_OFF = 0,
         DMA_READ,
-        DMA_WRITE
+        DMA_WRITE,
+        DMA_HALT,                       // Waiting to line up the first read, m_dmaTicksRemaining ticks left
+        DMA_STALL                       // Already copied, m_dmaTicksRemaining ticks left holding the CPU
+    };
+    
+    enum PPU_SCHEDULE : uint8_t
+    {
+        PPU_SCHEDULE_LOCKSTEP = 0,      // PPU ticked every master cycle
+        PPU_SCHEDULE_CATCHUP            // PPU only brought up to date when something could observe it
+    };
+    
+    enum CPU_SCHEDULE : uint8_t
+    {
+        CPU_SCHEDULE_CYCLE = 0,         // CPU stepped one T state per CPU tick
+        CPU_SCHEDULE_INSTRUCTION        // Whole instructions at once when they only touch RAM/ROM, cycle stepped otherwise
+    };
+    
+    struct IdleLoopStats
+    {
+        uint64_t    m_cpuTicks;         // Since power on or load
+        uint64_t    m_skippedTicks;     // Of those, fast forwarded through idle loops
+        float       m_skippedPercent;
     };
 
     SystemNES();
@@ -38,25 +60,97 @@ public:
 
     void Tick();
     
+    // Run for a number of master cycles (PPU ticks)
+    void RunCycles(uint64_t cycleCount);
+    
+    // Run up to and including the start of the next vblank, one full frame once in step
+    void RunFrame();
+    
+    // Output is identical either way, catch-up is faster
+    void SetPPUSchedule(PPU_SCHEDULE schedule);
+    
+    // Output is identical either way, instruction is faster
+    void SetCPUSchedule(CPU_SCHEDULE schedule);
+    
+    // Output is identical either way, scanline is faster
+    void SetSpriteEvaluation(PPUNES::SPRITE_EVALUATION evaluation);
+    
+    // Output is identical either way, skipping is faster - idle loops are only found with CPU_SCHEDULE_INSTRUCTION
+    // Loops polling RAM or a status register jump ahead to the first cycle something they can see could change
+    void SetIdleLoopSkip(bool bSkip);
+    IdleLoopStats GetIdleLoopStats() const;
+    
     virtual float AudioOut() override;
+    virtual bool HasAudioOut() override;
     virtual void SignalReset(bool bSignal) override;
     virtual void SignalNMI(bool bSignal) override;
     virtual void SignalIRQ(bool bSignal) override;
     virtual void SetMirrorMode(MirrorMode mode) override;
+    virtual uint64_t GetPPUCycleCount() override;
+    virtual uint64_t GetCycleCount() override;
+    virtual void ScheduleEvent(SystemEventHandler* pHandler, uint32_t eventID, uint64_t cycleCount) override;
+    virtual void CancelEvent(SystemEventHandler* pHandler, uint32_t eventID) override;
+    virtual bool cpuPlainMemoryPage(uint8_t page, bool bWrite) override;
+    virtual bool cpuStatusRegister(uint16_t address) override;
+    virtual void MapCPURead(uint16_t address, uint32_t size, uint8_t* pMemory) override;
+    virtual void MapCPUWrite(uint16_t address, uint32_t size, uint8_t* pMemory) override;
+    virtual void MapPPURead(uint16_t address, uint32_t size, uint8_t* pMemory) override;
+    virtual void SetPPUBusObserver(PPUBusObserver* pObserver) override;
+    virtual void SetCartVRAM(uint8_t* pCartVRAM) override;
 
     // assumed space for a 32bit colour 256x240 image data
     void SetVideoOutputDataPtr(uint32_t* pVideoOutData);
     
-    // Assumed space for 1 frame 1/60 worth of audio data
+    // 256x240 in any of the VideoFormats with a line stride in bytes
+    void SetVideoOutput(const VideoOutputDesc& output);
+    
+    // Assumed space for 1 frame 1/60 worth of audio data - the last buffer is padded out to its size when replaced
     void SetAudioOutputBuffer(APUAudioBuffer* pAudioBuffer);
     
+    // Empty the attached audio buffer for the next frame once its samples have been taken - see BeginAudioFrame in APUNES
+    void BeginAudioFrame();
+    
+    // Samples per second written to the audio buffer, 48000 by default - can change every frame for rate control, see AudioRateControl
+    void SetAudioSampleRate(double sampleRate);
+    
+    // Each APU channel and cart audio as interleaved stems alongside the audio output, nullptr (the default) to stop
+    void SetAudioStemBuffer(APUStemBuffer* pStemBuffer);
+    
     // port 0 = player 1
     void SetControllerBits(uint8_t port, uint8_t bits);
     
+private:
+    void ScheduleEvents();
+    void RunToCycle();
+    void TickPPUPhase();
+    void TickCPUPhase();
+    void TickCPU();
+    void SkipIdleLoop();
+    uint64_t IdleLoopEndCycle(uint16_t statusAddress);
+    void StartDMA(uint8_t page);
+    void TickDMA();
+    void TickPPU();
+    void SyncPPU();
+    void UpdatePPUSyncCycle();
+    void SyncAPU();
+    void MapCPUPages(uint8_t** pPageMap, uint16_t address, uint32_t size, uint8_t* pMemory);
+    void ResetMemoryMaps();
+    
 private:
     bool        m_bPowerOn;
     uint64_t    m_cycleCount;
     uint8_t     m_ram[2048];
+    
+    // CPU page (address >> 8) to memory - nullptr pages have side effects and go through the handlers
+    uint8_t*    m_cpuReadMap[256];
+    uint8_t*    m_cpuWriteMap[256];
+    
+    // Timed events - the run loop goes straight from one to the next
+    SystemEventQueue m_events;
+    uint64_t    m_runEndCycle;
+    
+    // Where RunCycles stops - a whole instruction is only run if it completes by then
+    uint64_t    m_runLimitCycle;
 
     CPU6502     m_cpu;
     PPUNES      m_ppu;
@@ -73,6 +167,24 @@ private:
     uint16_t    m_dmaAddress;
     uint8_t     m_dmaData;
     DMA_MODE    m_dmaMode;
+    uint16_t    m_dmaTicksRemaining;
+    
+    // PPU scheduling - m_ppuCycleCount trails m_cycleCount in catch-up mode
+    PPU_SCHEDULE m_ppuSchedule;
+    uint64_t    m_ppuCycleCount;
+    uint64_t    m_ppuSyncCycle;
+    
+    // APU scheduling - caught up on access, its own events and by m_apuSyncCycle
+    uint64_t    m_apuSyncCycle;
+    
+    // CPU scheduling - CPU ticks already run by the last whole instruction or skipped idle loop iterations
+    CPU_SCHEDULE m_cpuSchedule;
+    uint32_t    m_cpuTicksAhead;
+    
+    // Idle loop skipping - skipped CPU ticks since m_idleLoopStatsCycle
+    bool        m_bIdleLoopSkip;
+    uint64_t    m_idleLoopSkippedTicks;
+    uint64_t    m_idleLoopStatsCycle;
 };
 
 #endif /* SystemNES_h */
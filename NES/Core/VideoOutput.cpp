@@ -0,0 +1,221 @@
+//
+//  VideoOutput.cpp
+//  NES
+//
+
+#include "VideoOutput.h"
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define VIDEO_CONVERT_NEON 1
+#elif defined(__AVX2__)
+    #include <immintrin.h>
+    #define VIDEO_CONVERT_AVX2 1
+#endif
+
+// RGB for each of the 64 palette colours
+const uint8_t kPalletteRGB[] =
+{
+     84,  84,  84,    0,  30, 116,    8,  16, 144,   48,   0, 136,   68,   0, 100,   92,   0,  48,   84,   4,   0,   60,  24,   0,   32,  42,   0,    8,  58,   0,    0,  64,   0,    0,  60,   0,    0,  50,  60,    0,   0,   0,    0, 0, 0,  0, 0, 0,
+    152, 150, 152,    8,  76, 196,   48,  50, 236,   92,  30, 228,  136,  20, 176,  160,  20, 100,  152,  34,  32,  120,  60,   0,   84,  90,   0,   40, 114,   0,    8, 124,   0,    0, 118,  40,    0, 102, 120,    0,   0,   0,    0, 0, 0,  0, 0, 0,
+    236, 238, 236,   76, 154, 236,  120, 124, 236,  176,  98, 236,  228,  84, 236,  236,  88, 180,  236, 106, 100,  212, 136,  32,  160, 170,   0,  116, 196,   0,   76, 208,  32,   56, 204, 108,   56, 180, 204,   60,  60,  60,    0, 0, 0,  0, 0, 0,
+    236, 238, 236,  168, 204, 236,  188, 188, 236,  212, 178, 236,  236, 174, 236,  236, 174, 212,  236, 180, 176,  228, 196, 144,  204, 210, 120,  180, 222, 120,  168, 226, 144,  152, 226, 180,  160, 214, 228,  160, 162, 160,    0, 0, 0,  0, 0, 0,
+};
+
+// Emphasis darkens the channels it doesn't select
+const float kEmphasisAttenuation = 0.816328f;
+
+// Built once - each format per emphasis and colour, plus B, G, R, A byte planes for table lookups
+struct VideoColourTable
+{
+    VideoColourTable()
+    {
+        for(uint32_t emphasis = 0;emphasis < kVideoEmphasisCount;++emphasis)
+        {
+            for(uint32_t colour = 0;colour < kVideoColourCount;++colour)
+            {
+                uint32_t rgb[3];
+                for(uint32_t channel = 0;channel < 3;++channel)
+                {
+                    rgb[channel] = kPalletteRGB[colour * 3 + channel];
+
+                    // Any emphasis bit other than this channel's own
+                    if((emphasis & ~(1u << channel)) != 0)
+                    {
+                        rgb[channel] = uint32_t(float(rgb[channel]) * kEmphasisAttenuation + 0.5f);
+                    }
+                }
+
+                m_argb[emphasis][colour] = (0xFFu << 24) + (rgb[0] << 16) + (rgb[1] << 8) + (rgb[2] << 0);
+                m_abgr[emphasis][colour] = (0xFFu << 24) + (rgb[2] << 16) + (rgb[1] << 8) + (rgb[0] << 0);
+                m_rgb565[emphasis][colour] = uint16_t(((rgb[0] >> 3) << 11) | ((rgb[1] >> 2) << 5) | (rgb[2] >> 3));
+
+                m_planes[emphasis][0][colour] = uint8_t(rgb[2]);
+                m_planes[emphasis][1][colour] = uint8_t(rgb[1]);
+                m_planes[emphasis][2][colour] = uint8_t(rgb[0]);
+                m_planes[emphasis][3][colour] = 0xFF;
+            }
+        }
+    }
+
+    uint32_t m_argb[kVideoEmphasisCount][kVideoColourCount];
+    uint32_t m_abgr[kVideoEmphasisCount][kVideoColourCount];
+    uint16_t m_rgb565[kVideoEmphasisCount][kVideoColourCount];
+    uint8_t m_planes[kVideoEmphasisCount][4][kVideoColourCount];
+};
+
+static const VideoColourTable kVideoColours;
+
+uint32_t VideoColour(uint8_t colour, uint8_t emphasis)
+{
+    return kVideoColours.m_argb[emphasis & 0x7][colour & 0x3F];
+}
+
+// 32 bit table lookups - bRGBA swaps the red and blue byte planes for the vector lookups
+static void ConvertColours32Scalar(uint32_t* pOut, const uint8_t* pColours, uint32_t count, const uint32_t* pTable)
+{
+    for(uint32_t pixel = 0;pixel < count;++pixel)
+    {
+        pOut[pixel] = pTable[pColours[pixel] & 0x3F];
+    }
+}
+
+static void ConvertColours32(uint32_t* pOut, const uint8_t* pColours, uint32_t count, uint8_t emphasis, bool bRGBA)
+{
+    const uint32_t* pTable = bRGBA ? kVideoColours.m_abgr[emphasis & 0x7] : kVideoColours.m_argb[emphasis & 0x7];
+    uint32_t pixel = 0;
+
+#if VIDEO_CONVERT_NEON
+    // One 64 entry lookup per byte plane for 16 pixels, stored interleaved
+    const uint8_t* pPlanes = &kVideoColours.m_planes[emphasis & 0x7][0][0];
+    const uint8_t* pFirst = pPlanes + (bRGBA ? 2 : 0) * kVideoColourCount;
+    const uint8_t* pThird = pPlanes + (bRGBA ? 0 : 2) * kVideoColourCount;
+    uint8x16x4_t first, green, third;
+    for(uint32_t part = 0;part < 4;++part)
+    {
+        first.val[part] = vld1q_u8(pFirst + part * 16);
+        green.val[part] = vld1q_u8(pPlanes + 1 * kVideoColourCount + part * 16);
+        third.val[part] = vld1q_u8(pThird + part * 16);
+    }
+
+    const uint8x16_t colourMask = vdupq_n_u8(0x3F);
+    for(;pixel + 16 <= count;pixel += 16)
+    {
+        uint8x16_t colours = vandq_u8(vld1q_u8(pColours + pixel), colourMask);
+
+        uint8x16x4_t bytes;
+        bytes.val[0] = vqtbl4q_u8(first, colours);
+        bytes.val[1] = vqtbl4q_u8(green, colours);
+        bytes.val[2] = vqtbl4q_u8(third, colours);
+        bytes.val[3] = vdupq_n_u8(0xFF);
+        vst4q_u8((uint8_t*)(pOut + pixel), bytes);
+    }
+#elif VIDEO_CONVERT_AVX2
+    // 8 pixels per gather straight from the table
+    const int* pGather = (const int*)pTable;
+    const __m256i colourMask = _mm256_set1_epi32(0x3F);
+    for(;pixel + 8 <= count;pixel += 8)
+    {
+        __m256i colours = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(pColours + pixel)));
+        colours = _mm256_and_si256(colours, colourMask);
+        _mm256_storeu_si256((__m256i*)(pOut + pixel), _mm256_i32gather_epi32(pGather, colours, 4));
+    }
+#endif
+
+    // Whatever is left over
+    ConvertColours32Scalar(pOut + pixel, pColours + pixel, count - pixel, pTable);
+}
+
+void VideoConvertColoursScalar(uint32_t* pOut, const uint8_t* pColours, uint32_t count, uint8_t emphasis)
+{
+    ConvertColours32Scalar(pOut, pColours, count, kVideoColours.m_argb[emphasis & 0x7]);
+}
+
+void VideoConvertColours(uint32_t* pOut, const uint8_t* pColours, uint32_t count, uint8_t emphasis)
+{
+    ConvertColours32(pOut, pColours, count, emphasis, false);
+}
+
+uint32_t VideoBytesPerPixel(VideoFormat format)
+{
+    switch(format)
+    {
+        case VIDEO_FORMAT_BGRA8:
+        case VIDEO_FORMAT_RGBA8:
+            return 4;
+        case VIDEO_FORMAT_RGB565:
+        case VIDEO_FORMAT_INDEXED16:
+            return 2;
+        case VIDEO_FORMAT_INDEXED8:
+            return 1;
+        default:
+            break;
+    }
+    return 0;
+}
+
+uint32_t VideoLineStride(const VideoOutputDesc& output)
+{
+    return output.m_stride != 0 ? output.m_stride : kVideoWidth * VideoBytesPerPixel(output.m_format);
+}
+
+void VideoWriteColours(const VideoOutputDesc& output, uint32_t x, uint32_t y, const uint8_t* pColours, uint32_t count, uint8_t emphasis)
+{
+    uint8_t* pLine = (uint8_t*)output.m_pData + size_t(y) * VideoLineStride(output);
+    
+    switch(output.m_format)
+    {
+        case VIDEO_FORMAT_BGRA8:
+        {
+            ConvertColours32((uint32_t*)pLine + x, pColours, count, emphasis, false);
+            break;
+        }
+        case VIDEO_FORMAT_RGBA8:
+        {
+            ConvertColours32((uint32_t*)pLine + x, pColours, count, emphasis, true);
+            break;
+        }
+        case VIDEO_FORMAT_RGB565:
+        {
+            uint16_t* pOut = (uint16_t*)pLine + x;
+            const uint16_t* pTable = kVideoColours.m_rgb565[emphasis & 0x7];
+            for(uint32_t pixel = 0;pixel < count;++pixel)
+            {
+                pOut[pixel] = pTable[pColours[pixel] & 0x3F];
+            }
+            break;
+        }
+        case VIDEO_FORMAT_INDEXED8:
+        {
+            uint8_t* pOut = pLine + x;
+            for(uint32_t pixel = 0;pixel < count;++pixel)
+            {
+                pOut[pixel] = pColours[pixel] & 0x3F;
+            }
+            break;
+        }
+        case VIDEO_FORMAT_INDEXED16:
+        {
+            uint16_t* pOut = (uint16_t*)pLine + x;
+            const uint16_t emphasisBits = uint16_t(emphasis & 0x7) << 6;
+            for(uint32_t pixel = 0;pixel < count;++pixel)
+            {
+                pOut[pixel] = emphasisBits | (pColours[pixel] & 0x3F);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+const char* VideoConvertPath()
+{
+#if VIDEO_CONVERT_NEON
+    return "NEON";
+#elif VIDEO_CONVERT_AVX2
+    return "AVX2";
+#else
+    return "scalar";
+#endif
+}
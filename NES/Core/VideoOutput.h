@@ -0,0 +1,67 @@
+//
+//  VideoOutput.h
+//  NES
+//
+
+#ifndef VideoOutput_h
+#define VideoOutput_h
+
+#include "CoreDefines.h"
+
+const uint32_t kVideoWidth          = 256;
+const uint32_t kVideoHeight         = 240;
+
+// 64 colour palette x 8 PPUMASK emphasis settings (bit 0 red, bit 1 green, bit 2 blue)
+const uint32_t kVideoColourCount    = 64;
+const uint32_t kVideoEmphasisCount  = 8;
+
+enum VideoFormat : uint8_t
+{
+    VIDEO_FORMAT_BGRA8 = 0,         // 0xAARRGGBB words, B G R A in memory
+    VIDEO_FORMAT_RGBA8,             // R G B A in memory
+    VIDEO_FORMAT_RGB565,            // 16 bit 5:6:5
+    VIDEO_FORMAT_INDEXED8,          // 6 bit palette colour only - emphasis doesn't fit
+    VIDEO_FORMAT_INDEXED16,         // 6 bit palette colour | emphasis << 6 - the whole PPU output for a palette applied later
+    VIDEO_FORMAT_COUNT
+};
+
+// Where the PPU writes a 256x240 frame - stride is bytes per line, 0 for tightly packed lines
+struct VideoOutputDesc
+{
+    VideoOutputDesc()
+    : m_pData(nullptr)
+    , m_format(VIDEO_FORMAT_BGRA8)
+    , m_stride(0)
+    {}
+    
+    VideoOutputDesc(void* pData, VideoFormat format, uint32_t stride = 0)
+    : m_pData(pData)
+    , m_format(format)
+    , m_stride(stride)
+    {}
+    
+    void*       m_pData;
+    VideoFormat m_format;
+    uint32_t    m_stride;
+};
+
+uint32_t VideoBytesPerPixel(VideoFormat format);
+
+// Stride with 0 resolved to tightly packed lines
+uint32_t VideoLineStride(const VideoOutputDesc& output);
+
+// A run of 6 bit palette colours sharing one emphasis setting to line y of the output from pixel x
+void VideoWriteColours(const VideoOutputDesc& output, uint32_t x, uint32_t y, const uint8_t* pColours, uint32_t count, uint8_t emphasis);
+
+// 0xAARRGGBB for a 6 bit palette colour
+uint32_t VideoColour(uint8_t colour, uint8_t emphasis);
+
+// A run of 6 bit palette colours sharing one emphasis setting to 0xAARRGGBB
+// Uses NEON table lookups on arm64 and gathers when built with AVX2, otherwise the scalar loop
+void VideoConvertColours(uint32_t* pOut, const uint8_t* pColours, uint32_t count, uint8_t emphasis);
+void VideoConvertColoursScalar(uint32_t* pOut, const uint8_t* pColours, uint32_t count, uint8_t emphasis);
+
+// Which VideoConvertColours path this build uses
+const char* VideoConvertPath();
+
+#endif /* VideoOutput_h */
@@ -9,6 +9,8 @@
 #import "RenderDefs.h"
 #include "SystemNES.h"
 #include "Serialise.h"
+#include "AudioRingBuffer.h"
+#include "AudioRateControl.h"
 #import "AVFAudio/AVFAudio.h"
 #import <AudioToolbox/AudioToolbox.h>
 #import "Foundation/Foundation.h"
@@ -16,11 +18,13 @@
 // Global Constants
 const size_t    kRenderTextureCount = 2;
 const size_t    kArchiveCount       = 5 * 60;
-const int32_t   kAudioBufferCount   = 8;
 const float     kOutputMixerVolume  = 0.5;
 const int       kRewindFlashFrames  = 8;
 const uint32_t  kAudioPrecessingSampleRate = 48000;
 const uint32_t  kAudioSampleBuffserElementSize = kAudioPrecessingSampleRate / 60;
+const uint32_t  kAudioFrameBufferSize = kAudioSampleBuffserElementSize * 2;        // One emulated frame of samples with room to spare
+const uint32_t  kAudioRingSize = kAudioSampleBuffserElementSize * 8;               // Emulated frames the output can fall behind by
+const uint32_t  kAudioRingTargetLevel = kAudioSampleBuffserElementSize * 3;        // Buffered before output (re)starts and held there by rate control
 
 Vertex const    kQuadVerts[]        = {{{-1.f,-1.f,0.f,1.f},    {0.f,1.f}},
                                         {{1.f,1.f,0.f,1.f},     {1.f,0.f}},
@@ -47,12 +51,13 @@ Vertex const    kQuadVerts[]        = {{{-1.f,-1.f,0.f,1.f},    {0.f,1.f}},
     size_t          m_rewindStartIndex;
     Archive         m_ArchiveBuffer[kArchiveCount];
     
-    // Audio buffers
+    // Audio buffers - each frame's samples go from the APU buffer into the ring the output reads from
     bool                    m_allowAudio;
     std::atomic<bool>       m_audioSynced;
-    std::atomic<int32_t>    m_readAudioBuffer;
-    std::atomic<int32_t>    m_writeAudioBuffer;
-    APUAudioBuffer          m_audioBuffers[kAudioBufferCount];
+    std::atomic<bool>       m_audioFlushRequested;      // Render block empties the ring - only the consumer can
+    APUAudioBuffer          m_audioFrameBuffer;
+    AudioRingBuffer         m_audioRing;
+    AudioRateControl        m_audioRateControl;
     
     // The console we are emulating
     SystemNES m_NESConsole;
@@ -158,13 +163,9 @@ Vertex const    kQuadVerts[]        = {{{-1.f,-1.f,0.f,1.f},    {0.f,1.f}},
     m_allowAudio = false;
     m_audioSynced = false;
     
-    m_readAudioBuffer = 0;
-    m_writeAudioBuffer = 0;
-    
-     for(size_t i = 0;i < kAudioBufferCount;++i)
-    {
-        m_audioBuffers[i].Reset();
-    }
+    // The render block may still be running and the producer still writing - neither can be reset from here
+    m_audioFlushRequested = true;
+    m_audioRateControl.Reset();
 }
 
 - (void) allowAudio
@@ -172,6 +173,21 @@ Vertex const    kQuadVerts[]        = {{{-1.f,-1.f,0.f,1.f},    {0.f,1.f}},
     m_allowAudio = true;
 }
 
+- (void) startAudio
+{
+    // Rate control and the ring start again together - whatever they held was for the last time audio ran
+    m_audioRateControl.Reset();
+    m_NESConsole.SetAudioSampleRate(kAudioPrecessingSampleRate);
+    m_audioFlushRequested = true;
+    m_audioSynced = false;
+    
+    self.audioEngine.mainMixerNode.outputVolume = 0.f;
+    if(![self.audioEngine startAndReturnError:nil])
+    {
+        NSLog(@"Failed to start audio engine");
+    }
+}
+
 - (void) showOpenNewDialogue
 {
     dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.25 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^
@@ -252,8 +268,7 @@ Vertex const    kQuadVerts[]        = {{{-1.f,-1.f,0.f,1.f},    {0.f,1.f}},
             m_rewindStartIndex = 0;
             m_allowAudio = false;
             m_audioSynced = false;
-            m_readAudioBuffer = 0;
-            m_writeAudioBuffer = 0;
+            m_audioFlushRequested = false;
             m_keyboardPort = 0;
             m_keyboardController[0] = m_keyboardController[1] = 0;
             
@@ -264,10 +279,11 @@ Vertex const    kQuadVerts[]        = {{{-1.f,-1.f,0.f,1.f},    {0.f,1.f}},
             }
             
             // Initialise our audio buffer objects, 48000 KHz each frame 1/60 second = x samples per video frame
-            for(size_t i = 0;i < kAudioBufferCount;++i)
-            {
-                new (&m_audioBuffers[i]) APUAudioBuffer(kAudioSampleBuffserElementSize);
-            }
+            new (&m_audioFrameBuffer) APUAudioBuffer(kAudioFrameBufferSize);
+            new (&m_audioRing) AudioRingBuffer(kAudioRingSize);
+            new (&m_audioRateControl) AudioRateControl(kAudioPrecessingSampleRate, kAudioRingTargetLevel);
+            m_NESConsole.SetAudioSampleRate(kAudioPrecessingSampleRate);
+            m_NESConsole.SetAudioOutputBuffer(&m_audioFrameBuffer);
         }
     
         self.device = MTLCreateSystemDefaultDevice();
@@ -337,26 +353,33 @@ Vertex const    kQuadVerts[]        = {{{-1.f,-1.f,0.f,1.f},    {0.f,1.f}},
                         AudioBuffer* pOutputAudioBuffer = &pOutputData->mBuffers[0];
                         float* pOutputFloatBuffer = (float*)pOutputAudioBuffer->mData;
                                             
-                        const bool bAudioSynced = self->m_audioSynced;
-                        int32_t bufferIndexDiff = abs(self->m_writeAudioBuffer - self->m_readAudioBuffer);
+                        AudioRingBuffer& audioRing = self->m_audioRing;
                         
-                        // Audio not currently synced - try to use optimal readbuffer vs writebuffer index before syncing
-                        // Audio currently synced - try to keep going - as long as we have valid data
-                        if (    (!bAudioSynced && bufferIndexDiff > ((kAudioBufferCount / 2) - 1)) ||
-                                ( bAudioSynced && bufferIndexDiff > 0))
+                        // Anything buffered before audio was stopped is stale
+                        if(self->m_audioFlushRequested.exchange(false))
                         {
-                            APUAudioBuffer const* pInputAudioBuffer = &self->m_audioBuffers[self->m_readAudioBuffer];
-                            const size_t samplesWritten = pInputAudioBuffer->GetSamplesWritten();
+                            audioRing.Flush();
+                            self->m_audioSynced = false;
+                        }
+                        
+                        // Audio not currently synced - wait for a few frames of samples before starting again
+                        // Audio currently synced - take whatever the host asks for as long as we have valid data
+                        if(self->m_audioSynced || audioRing.GetFillLevel() >= kAudioRingTargetLevel)
+                        {
+                            const uint32_t samplesRead = audioRing.Read(pOutputFloatBuffer, frameCount);
                             
-                            if(pInputAudioBuffer->IsReady() && samplesWritten == frameCount)
+                            // Ran dry - hold the last sample to the end rather than click, then wait to refill
+                            const float fLastSample = samplesRead > 0 ? pOutputFloatBuffer[samplesRead - 1] : 0.f;
+                            for(uint32_t i = samplesRead;i < frameCount;++i)
                             {
-                                float const* pInputFloatBuffer = pInputAudioBuffer->GetSampleBuffer();
-                                
-                                memcpy(pOutputFloatBuffer, pInputFloatBuffer, samplesWritten * sizeof(float));
-
-                                self->m_readAudioBuffer = (self->m_readAudioBuffer + 1) % kAudioBufferCount;
-                                bOutputBufferWritten = true;
+                                pOutputFloatBuffer[i] = fLastSample;
                             }
+                            
+                            bOutputBufferWritten = samplesRead == frameCount;
+                        }
+                        else
+                        {
+                            memset(pOutputFloatBuffer, 0, frameCount * sizeof(float));
                         }
 
                         self->m_audioSynced = bOutputBufferWritten;
@@ -473,30 +496,28 @@ Vertex const    kQuadVerts[]        = {{{-1.f,-1.f,0.f,1.f},    {0.f,1.f}},
             
             // Audio
             {
-                APUAudioBuffer* pCurrentAudioBuffer = &m_audioBuffers[m_writeAudioBuffer];
-                                
-                pCurrentAudioBuffer->SetShouldReverseBuffer(m_emulationDirection < 0);
+                // Stays attached, emptied each frame once the ring has its samples - after which the flag can be set
+                m_NESConsole.BeginAudioFrame();
                 
-                m_NESConsole.SetAudioOutputBuffer(pCurrentAudioBuffer);
-                m_writeAudioBuffer = (m_writeAudioBuffer + 1) % kAudioBufferCount;
+                m_audioFrameBuffer.SetShouldReverseBuffer(m_emulationDirection < 0);
             }
         }
         
-        // Tick emulation
-        // 341 x 262 = [scanline time + hBlank time in scanline dots] X [scanline count + vBlank time in scanlines]
-        const size_t kNumPPUTicksPerFrame = 89342;
-        for(size_t i = 0;i < kNumPPUTicksPerFrame;++i)
+        // Tick emulation - runs up to the start of the next vblank
+        m_NESConsole.RunFrame();
+        
+        // Only while something is reading - otherwise the ring sits full and rate control winds down to its limit
+        if(m_allowAudio && self.audioEngine.isRunning)
         {
-            m_NESConsole.Tick();
+            // Hand the frame's samples to the output - any that don't fit are dropped while the output catches up
+            m_audioRing.Write(m_audioFrameBuffer.GetWrittenSamples(), uint32_t(m_audioFrameBuffer.GetSamplesWritten()));
+            
+            // Display refresh isn't the NES 60.0988Hz or locked to the audio clock - keep the ring near its target fill level
+            m_NESConsole.SetAudioSampleRate(m_audioRateControl.Update(m_audioRing.GetFillLevel()));
         }
-        
-        if(m_allowAudio && !self.audioEngine.isRunning)
+        else if(m_allowAudio)
         {
-            self.audioEngine.mainMixerNode.outputVolume = 0.f;
-            if(![self.audioEngine startAndReturnError:nil])
-            {
-                NSLog(@"Failed to start audio engine");
-            }
+            [self startAudio];
         }
     }
     
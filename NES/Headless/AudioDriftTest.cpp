@@ -0,0 +1,227 @@
+//
+//  AudioDriftTest.cpp
+//  NES
+//
+//  Audio latency under clock drift - frames paced by a simulated display, samples taken by a simulated audio
+//  clock that runs slightly fast or slow, handed over through the ring the way the frontend does
+//  Passes when rate control holds the ring fill level inside the latency window after settling, and the same
+//  drift without rate control leaves it
+//  Usage: nes-audio-drift-test [seconds]
+//
+
+#include "SystemNES.h"
+#include "AudioRingBuffer.h"
+#include "AudioRateControl.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+const uint32_t  kDefaultSeconds         = 120;
+const uint32_t  kSettleSeconds          = 30;
+const double    kAudioSampleRate        = 48000.0;
+const uint32_t  kAudioSamplesPerFrame   = 48000 / 60;
+const uint32_t  kAudioFrameBufferSize   = kAudioSamplesPerFrame * 2;
+const uint32_t  kAudioRingSize          = kAudioSamplesPerFrame * 8;
+const uint32_t  kAudioRingTargetLevel   = kAudioSamplesPerFrame * 3;
+const uint32_t  kHostBufferSize         = 512;
+
+// Fill level just before each host read - within half the target either side
+const uint32_t  kLatencyWindowMin       = kAudioRingTargetLevel / 2;
+const uint32_t  kLatencyWindowMax       = kAudioRingTargetLevel * 3 / 2;
+
+const char* const kTestCartPath         = "audio_drift_test.nes";
+
+struct DriftCase
+{
+    const char* m_pName;
+    double      m_displayRate;              // Frames per second
+    double      m_hostClockDrift;           // Audio clock error, +0.001 takes samples 0.1% fast
+    bool        m_bRateControl;
+    bool        m_bExpectInWindow;
+};
+
+const DriftCase kDriftCases[] =
+{
+    { "60Hz display",                   60.0,       0.0,        true,   true },
+    { "60Hz display, audio +0.1%",      60.0,       0.001,      true,   true },
+    { "60Hz display, audio -0.1%",      60.0,       -0.001,     true,   true },
+    { "59.94Hz display, audio +0.05%",  59.94,      0.0005,     true,   true },
+    { "NES rate display, audio -0.2%",  60.0988,    -0.002,     true,   true },
+    { "60Hz display, no rate control",  60.0,       0.0,        false,  false },
+};
+
+// NROM cart that starts a held pulse tone and spins - audio out every frame with no game logic
+static bool WriteTestCart(const char* pPath)
+{
+    const uint8_t program[] =
+    {
+        0xA9, 0x0F, 0x8D, 0x15, 0x40,       // LDA #$0F, STA $4015 - enable channels
+        0xA9, 0xBF, 0x8D, 0x00, 0x40,       // LDA #$BF, STA $4000 - 50% duty, length halted, constant volume 15
+        0xA9, 0x00, 0x8D, 0x01, 0x40,       // LDA #$00, STA $4001 - no sweep
+        0xA9, 0xFD, 0x8D, 0x02, 0x40,       // LDA #$FD, STA $4002 - ~440Hz
+        0xA9, 0x00, 0x8D, 0x03, 0x40,       // LDA #$00, STA $4003
+        0x4C, 0x19, 0x80,                   // JMP $8019
+        0x40,                               // RTI - NMI and IRQ
+    };
+    const uint16_t resetVector = 0x8000;
+    const uint16_t interruptVector = 0x8000 + sizeof(program) - 1;
+
+    std::vector<uint8_t> cart(16 + 16384 + 8192, 0);
+    const uint8_t header[] = { 0x4E, 0x45, 0x53, 0x1A, 1, 1 };
+    memcpy(cart.data(), header, sizeof(header));
+
+    uint8_t* pPRG = cart.data() + 16;
+    memcpy(pPRG, program, sizeof(program));
+    const uint16_t vectors[] = { interruptVector, resetVector, interruptVector };
+    for(uint32_t i = 0;i < 3;++i)
+    {
+        pPRG[0x3FFA + i * 2] = uint8_t(vectors[i] & 0xFF);
+        pPRG[0x3FFB + i * 2] = uint8_t(vectors[i] >> 8);
+    }
+
+    FILE* pFile = fopen(pPath, "wb");
+    if(pFile == nullptr)
+    {
+        return false;
+    }
+    const bool bWritten = fwrite(cart.data(), 1, cart.size(), pFile) == cart.size();
+    fclose(pFile);
+    return bWritten;
+}
+
+// Runs one case as the frontend would - returns true when the fill level stayed in the window after settling
+static bool RunDriftCase(const DriftCase& driftCase, uint32_t seconds)
+{
+    SystemNES* pConsole = new SystemNES();
+    if(!pConsole->InsertCartridge(kTestCartPath))
+    {
+        fprintf(stderr, "Failed to load: %s\n", kTestCartPath);
+        delete pConsole;
+        return false;
+    }
+    pConsole->PowerOn();
+    pConsole->SetAudioSampleRate(kAudioSampleRate);
+
+    APUAudioBuffer audioFrameBuffer(kAudioFrameBufferSize);
+    AudioRingBuffer audioRing(kAudioRingSize);
+    AudioRateControl audioRateControl(kAudioSampleRate, kAudioRingTargetLevel);
+    std::vector<float> hostBuffer(kHostBufferSize);
+
+    const double frameTime = 1.0 / driftCase.m_displayRate;
+    const double hostBufferTime = double(kHostBufferSize) / (kAudioSampleRate * (1.0 + driftCase.m_hostClockDrift));
+
+    double nextFrameTime = 0.0;
+    double nextHostBufferTime = hostBufferTime;
+    bool bAudioSynced = false;
+
+    uint32_t minFillLevel = kAudioRingSize;
+    uint32_t maxFillLevel = 0;
+    uint64_t settleUnderruns = 0;
+    uint64_t settleDropped = 0;
+    bool bSettled = false;
+
+    pConsole->SetAudioOutputBuffer(&audioFrameBuffer);
+
+    // Whichever clock is due next, until both have passed the end
+    while(nextFrameTime < double(seconds) || nextHostBufferTime < double(seconds))
+    {
+        if(nextFrameTime <= nextHostBufferTime)
+        {
+            pConsole->BeginAudioFrame();
+            pConsole->RunFrame();
+
+            audioRing.Write(audioFrameBuffer.GetWrittenSamples(), uint32_t(audioFrameBuffer.GetSamplesWritten()));
+            if(driftCase.m_bRateControl)
+            {
+                pConsole->SetAudioSampleRate(audioRateControl.Update(audioRing.GetFillLevel()));
+            }
+
+            nextFrameTime += frameTime;
+        }
+        else
+        {
+            // Counted from here on
+            if(!bSettled && nextHostBufferTime >= double(kSettleSeconds))
+            {
+                bSettled = true;
+                settleUnderruns = audioRing.GetUnderrunSamples();
+                settleDropped = audioRing.GetDroppedSamples();
+            }
+
+            const uint32_t fillLevel = audioRing.GetFillLevel();
+
+            // Same start and underrun handling as the frontend render block
+            if(bAudioSynced || fillLevel >= kAudioRingTargetLevel)
+            {
+                bAudioSynced = audioRing.Read(hostBuffer.data(), kHostBufferSize) == kHostBufferSize;
+            }
+
+            if(bSettled)
+            {
+                minFillLevel = fillLevel < minFillLevel ? fillLevel : minFillLevel;
+                maxFillLevel = fillLevel > maxFillLevel ? fillLevel : maxFillLevel;
+            }
+
+            nextHostBufferTime += hostBufferTime;
+        }
+    }
+
+    pConsole->SetAudioOutputBuffer(nullptr);
+    pConsole->EjectCartridge();
+    delete pConsole;
+
+    const uint64_t settledUnderruns = audioRing.GetUnderrunSamples() - settleUnderruns;
+    const uint64_t settledDropped = audioRing.GetDroppedSamples() - settleDropped;
+    const bool bInWindow = settledUnderruns == 0 && settledDropped == 0 && minFillLevel >= kLatencyWindowMin && maxFillLevel <= kLatencyWindowMax;
+    const bool bPassed = bInWindow == driftCase.m_bExpectInWindow;
+
+    printf("%-32s latency %5.1f - %5.1f ms  underrun %6llu  rate %8.1f  %s\n",
+           driftCase.m_pName,
+           double(minFillLevel) * 1000.0 / kAudioSampleRate,
+           double(maxFillLevel) * 1000.0 / kAudioSampleRate,
+           (unsigned long long)settledUnderruns,
+           driftCase.m_bRateControl ? audioRateControl.GetSampleRate() : kAudioSampleRate,
+           bPassed ? "ok" : "FAILED");
+
+    return bPassed;
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t seconds = kDefaultSeconds;
+    if(argc > 1)
+    {
+        seconds = (uint32_t)strtoul(argv[1], nullptr, 10);
+    }
+    if(seconds <= kSettleSeconds)
+    {
+        fprintf(stderr, "Needs more than the %u seconds to settle\n", kSettleSeconds);
+        return 1;
+    }
+
+    if(!WriteTestCart(kTestCartPath))
+    {
+        fprintf(stderr, "Failed to write: %s\n", kTestCartPath);
+        return 1;
+    }
+
+    printf("latency window %.1f - %.1f ms, target %.1f ms\n",
+           double(kLatencyWindowMin) * 1000.0 / kAudioSampleRate,
+           double(kLatencyWindowMax) * 1000.0 / kAudioSampleRate,
+           double(kAudioRingTargetLevel) * 1000.0 / kAudioSampleRate);
+
+    uint32_t failedCount = 0;
+    for(const DriftCase& driftCase : kDriftCases)
+    {
+        if(!RunDriftCase(driftCase, seconds))
+        {
+            ++failedCount;
+        }
+    }
+
+    remove(kTestCartPath);
+
+    return failedCount == 0 ? 0 : 1;
+}
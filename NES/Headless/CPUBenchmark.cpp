@@ -0,0 +1,164 @@
+//
+//  CPUBenchmark.cpp
+//  NES
+//
+//  CPU6502 on its own against a flat 64KB RAM bus - measures the cost of instruction dispatch
+//  Built once per dispatch mode (nes-cpu-bench and nes-cpu-bench-table) so they can be compared
+//  Usage: nes-cpu-bench [-instruction] [cpuTicks]
+//
+
+#include "CPU6502.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+const uint64_t  kDefaultTickCount       = 200000000;
+const uint16_t  kProgramAddress         = 0x8000;
+const uint16_t  kLoopCounterL           = 0x0040;
+const uint16_t  kLoopCounterH           = 0x0041;
+const uint64_t  kInstructionsPerLoop    = 18;
+const uint64_t  kInstructionsPerWrap    = 2;
+
+// Mix of the common address modes, a subroutine call and stack use
+const uint8_t kProgram[] =
+{
+    0xA2, 0x00,             //          LDX #0
+    0xA0, 0x00,             //          LDY #0
+    0xBD, 0x00, 0x02,       // loop:    LDA $0200,X
+    0x69, 0x01,             //          ADC #$01
+    0x9D, 0x00, 0x03,       //          STA $0300,X
+    0xB1, 0x10,             //          LDA ($10),Y
+    0x45, 0x20,             //          EOR $20
+    0x85, 0x21,             //          STA $21
+    0xE6, 0x22,             //          INC $22
+    0x0E, 0x00, 0x04,       //          ASL $0400
+    0xB4, 0x23,             //          LDY $23,X
+    0x20, 0x28, 0x80,       //          JSR sub
+    0x48,                   //          PHA
+    0x68,                   //          PLA
+    0xE8,                   //          INX
+    0xE6, 0x40,             //          INC $40
+    0xD0, 0xE1,             //          BNE loop
+    0xE6, 0x41,             //          INC $41
+    0x4C, 0x04, 0x80,       //          JMP loop
+    0xA1, 0x30,             // sub:     LDA ($30,X)
+    0x6A,                   //          ROR A
+    0x60,                   //          RTS
+};
+
+class BenchmarkBus final : public IOBus
+{
+public:
+    BenchmarkBus()
+    : m_loopCount(0)
+    , m_wrapCount(0)
+    {
+        memset(m_memory, 0x00, sizeof(m_memory));
+        memcpy(&m_memory[kProgramAddress], kProgram, sizeof(kProgram));
+
+        // Reset vector
+        m_memory[0xFFFC] = kProgramAddress & 0xFF;
+        m_memory[0xFFFD] = kProgramAddress >> 8;
+
+        // Some varied data for the loads to work on
+        for(uint32_t i = 0x0200;i < 0x0500;++i)
+        {
+            m_memory[i] = uint8_t(i * 37);
+        }
+    }
+
+    virtual uint8_t cpuRead(uint16_t address) override
+    {
+        return m_memory[address];
+    }
+
+    virtual void cpuWrite(uint16_t address, uint8_t byte) override
+    {
+        // Count loop iterations by the counter writes
+        if(address == kLoopCounterL)
+        {
+            ++m_loopCount;
+        }
+        else if(address == kLoopCounterH)
+        {
+            ++m_wrapCount;
+        }
+        m_memory[address] = byte;
+    }
+
+    virtual uint8_t ppuRead(uint16_t) override                 { return 0; }
+    virtual void    ppuWrite(uint16_t, uint8_t) override        {}
+    
+    // All RAM - every instruction can run in one go
+    virtual bool    cpuPlainMemoryPage(uint8_t, bool) override { return true; }
+
+    uint64_t InstructionCount() const
+    {
+        return m_loopCount * kInstructionsPerLoop + m_wrapCount * kInstructionsPerWrap;
+    }
+
+private:
+    uint8_t     m_memory[0x10000];
+    uint64_t    m_loopCount;
+    uint64_t    m_wrapCount;
+};
+
+int main(int argc, char* argv[])
+{
+    uint64_t tickCount = kDefaultTickCount;
+    bool bInstruction = false;
+    
+    for(int arg = 1;arg < argc;++arg)
+    {
+        if(strcmp(argv[arg], "-instruction") == 0)
+        {
+            bInstruction = true;
+        }
+        else
+        {
+            tickCount = strtoull(argv[arg], nullptr, 10);
+        }
+    }
+
+    BenchmarkBus bus;
+    CPU6502 cpu(bus);
+    cpu.PowerOn();
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    if(bInstruction)
+    {
+        // May overshoot by the rest of the last instruction
+        uint64_t tick = 0;
+        while(tick < tickCount)
+        {
+            tick += cpu.TickInstruction();
+        }
+        tickCount = tick;
+    }
+    else
+    {
+        for(uint64_t tick = 0;tick < tickCount;++tick)
+        {
+            cpu.Tick();
+        }
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>(endTime - startTime).count();
+    const uint64_t instructionCount = bus.InstructionCount();
+
+    printf("dispatch:           %s\n", CPU6502_SWITCH_DISPATCH ? "switch" : "function pointer table");
+    printf("stepping:           %s\n", bInstruction ? "instruction" : "cycle");
+    printf("cpu ticks:          %llu\n", (unsigned long long)tickCount);
+    printf("instructions:       %llu\n", (unsigned long long)instructionCount);
+    printf("ticks/instruction:  %.3f\n", double(tickCount) / double(instructionCount));
+    printf("ns/tick:            %.3f\n", seconds * 1e9 / double(tickCount));
+    printf("ns/instruction:     %.3f\n", seconds * 1e9 / double(instructionCount));
+    printf("emulated MHz:       %.1f\n", double(tickCount) / seconds / 1e6);
+
+    return 0;
+}
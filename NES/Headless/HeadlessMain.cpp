@@ -0,0 +1,308 @@
+//
+//  HeadlessMain.cpp
+//  NES
+//
+//  Command line runner for the emulation core - no Metal or AVFoundation
+//  Usage: nes-headless <cart.nes | cart.nes.save> [frameCount]
+//
+
+#include "SystemNES.h"
+#include "Serialise.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+const uint32_t  kDefaultFrameCount          = 600;
+const uint32_t  kAudioSampleRate            = 48000;
+const uint32_t  kAudioSamplesPerFrame       = kAudioSampleRate / 60;
+
+static bool HasSuffix(const char* pString, const char* pSuffix)
+{
+    const size_t stringLen = strlen(pString);
+    const size_t suffixLen = strlen(pSuffix);
+
+    if(stringLen < suffixLen)
+    {
+        return false;
+    }
+
+    return strcasecmp(pString + stringLen - suffixLen, pSuffix) == 0;
+}
+
+// FNV-1a over the last frame - a cheap way to compare output between runs
+static uint64_t HashBytes(void const* pData, size_t count)
+{
+    uint8_t const* pBytes = (uint8_t const*)pData;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for(size_t i = 0;i < count;++i)
+    {
+        hash ^= pBytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static bool LoadConsole(SystemNES& console, const char* pPath)
+{
+    if(HasSuffix(pPath, ".nes.save"))
+    {
+        Archive archive(ArchiveMode_Persistent);
+        if(archive.Load(pPath) && archive.ByteCount() > 0)
+        {
+            console.Load(archive);
+            return true;
+        }
+    }
+    else if(HasSuffix(pPath, ".nes"))
+    {
+        if(console.InsertCartridge(pPath))
+        {
+            console.PowerOn();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Float WAV with one channel per APUStem in order - sizes are filled in by FinishStemWAV
+static void WriteLE16(FILE* pFile, uint16_t value)
+{
+    const uint8_t bytes[2] = { uint8_t(value), uint8_t(value >> 8) };
+    fwrite(bytes, 1, sizeof(bytes), pFile);
+}
+
+static void WriteLE32(FILE* pFile, uint32_t value)
+{
+    const uint8_t bytes[4] = { uint8_t(value), uint8_t(value >> 8), uint8_t(value >> 16), uint8_t(value >> 24) };
+    fwrite(bytes, 1, sizeof(bytes), pFile);
+}
+
+const uint32_t kStemWAVHeaderSize = 68;
+
+static void WriteStemWAVHeader(FILE* pFile, uint32_t sampleRate, uint32_t frameCount)
+{
+    const uint32_t frameBytes = APU_STEM_COUNT * sizeof(float);
+    const uint32_t dataBytes = frameCount * frameBytes;
+
+    fwrite("RIFF", 1, 4, pFile);
+    WriteLE32(pFile, kStemWAVHeaderSize - 8 + dataBytes);
+    fwrite("WAVE", 1, 4, pFile);
+
+    // WAVE_FORMAT_EXTENSIBLE - more than 2 channels, no speaker positions
+    fwrite("fmt ", 1, 4, pFile);
+    WriteLE32(pFile, 40);
+    WriteLE16(pFile, 0xFFFE);
+    WriteLE16(pFile, APU_STEM_COUNT);
+    WriteLE32(pFile, sampleRate);
+    WriteLE32(pFile, sampleRate * frameBytes);
+    WriteLE16(pFile, frameBytes);
+    WriteLE16(pFile, 32);
+    WriteLE16(pFile, 22);
+    WriteLE16(pFile, 32);
+    WriteLE32(pFile, 0);
+
+    // KSDATAFORMAT_SUBTYPE_IEEE_FLOAT
+    const uint8_t subFormat[16] = { 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71 };
+    fwrite(subFormat, 1, sizeof(subFormat), pFile);
+
+    fwrite("data", 1, 4, pFile);
+    WriteLE32(pFile, dataBytes);
+}
+
+static void FinishStemWAV(FILE* pFile, uint32_t sampleRate, uint32_t frameCount)
+{
+    fseek(pFile, 0, SEEK_SET);
+    WriteStemWAVHeader(pFile, sampleRate, frameCount);
+    fclose(pFile);
+}
+
+// Command line names for each VideoFormat
+const char* const kVideoFormatNames[VIDEO_FORMAT_COUNT] = { "bgra8", "rgba8", "rgb565", "indexed8", "indexed16" };
+
+static bool ParseVideoFormat(const char* pName, VideoFormat& format)
+{
+    for(uint32_t index = 0;index < VIDEO_FORMAT_COUNT;++index)
+    {
+        if(strcasecmp(pName, kVideoFormatNames[index]) == 0)
+        {
+            format = VideoFormat(index);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void PrintUsage(const char* pExecutable)
+{
+    fprintf(stderr, "Usage: %s [options] <cart.nes | cart.nes.save> [frameCount]\n", pExecutable);
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "  -lockstep    Tick the PPU every master cycle instead of catching it up on demand\n");
+    fprintf(stderr, "  -cpucycle    Step the CPU every cycle instead of running whole RAM/ROM only instructions at once\n");
+    fprintf(stderr, "  -spritedot   Evaluate sprites dot by dot instead of a whole scanline at once\n");
+    fprintf(stderr, "  -noidleskip  Run idle polling loops cycle by cycle instead of skipping to the next event that could end them\n");
+    fprintf(stderr, "  -format <f>  Video output format - bgra8 (default), rgba8, rgb565, indexed8 or indexed16\n");
+    fprintf(stderr, "  -stems <wav> Write pulse1, pulse2, triangle, noise, DMC and cart audio as a 6 channel float WAV\n");
+}
+
+int main(int argc, char* argv[])
+{
+    const char* pCartPath = nullptr;
+    uint32_t frameCount = kDefaultFrameCount;
+    bool bLockstep = false;
+    bool bCPUCycle = false;
+    bool bSpriteDot = false;
+    bool bIdleLoopSkip = true;
+    VideoFormat videoFormat = VIDEO_FORMAT_BGRA8;
+    const char* pStemPath = nullptr;
+    
+    uint32_t positionalCount = 0;
+    for(int arg = 1;arg < argc;++arg)
+    {
+        if(strcmp(argv[arg], "-lockstep") == 0)
+        {
+            bLockstep = true;
+        }
+        else if(strcmp(argv[arg], "-cpucycle") == 0)
+        {
+            bCPUCycle = true;
+        }
+        else if(strcmp(argv[arg], "-spritedot") == 0)
+        {
+            bSpriteDot = true;
+        }
+        else if(strcmp(argv[arg], "-noidleskip") == 0)
+        {
+            bIdleLoopSkip = false;
+        }
+        else if(strcmp(argv[arg], "-format") == 0)
+        {
+            if(arg + 1 >= argc || !ParseVideoFormat(argv[arg + 1], videoFormat))
+            {
+                PrintUsage(argv[0]);
+                return 1;
+            }
+            ++arg;
+        }
+        else if(strcmp(argv[arg], "-stems") == 0)
+        {
+            if(arg + 1 >= argc)
+            {
+                PrintUsage(argv[0]);
+                return 1;
+            }
+            pStemPath = argv[++arg];
+        }
+        else if(argv[arg][0] == '-')
+        {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+        else if(positionalCount == 0)
+        {
+            pCartPath = argv[arg];
+            ++positionalCount;
+        }
+        else if(positionalCount == 1)
+        {
+            frameCount = (uint32_t)strtoul(argv[arg], nullptr, 10);
+            ++positionalCount;
+        }
+    }
+
+    if(pCartPath == nullptr)
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    // Console is large - keep it off the stack
+    SystemNES* pConsole = new SystemNES();
+
+    if(!LoadConsole(*pConsole, pCartPath))
+    {
+        fprintf(stderr, "Failed to load: %s\n", pCartPath);
+        delete pConsole;
+        return 1;
+    }
+
+    pConsole->SetPPUSchedule(bLockstep ? SystemNES::PPU_SCHEDULE_LOCKSTEP : SystemNES::PPU_SCHEDULE_CATCHUP);
+    pConsole->SetCPUSchedule(bCPUCycle ? SystemNES::CPU_SCHEDULE_CYCLE : SystemNES::CPU_SCHEDULE_INSTRUCTION);
+    pConsole->SetSpriteEvaluation(bSpriteDot ? PPUNES::SPRITE_EVALUATION_DOT : PPUNES::SPRITE_EVALUATION_SCANLINE);
+    pConsole->SetIdleLoopSkip(bIdleLoopSkip);
+    pConsole->SetAudioSampleRate(kAudioSampleRate);
+
+    std::vector<uint8_t> videoOutput(kVideoWidth * kVideoHeight * VideoBytesPerPixel(videoFormat), 0);
+    APUAudioBuffer audioOutput(kAudioSamplesPerFrame);
+
+    pConsole->SetVideoOutput(VideoOutputDesc(videoOutput.data(), videoFormat));
+
+    // Stems are captured frame by frame and appended, the header is written again with the sizes at the end
+    APUStemBuffer stemOutput(kAudioSamplesPerFrame * 2);
+    FILE* pStemFile = nullptr;
+    uint32_t stemFrameCount = 0;
+    if(pStemPath != nullptr)
+    {
+        pStemFile = fopen(pStemPath, "wb");
+        if(pStemFile == nullptr)
+        {
+            fprintf(stderr, "Failed to write: %s\n", pStemPath);
+            pConsole->EjectCartridge();
+            delete pConsole;
+            return 1;
+        }
+        WriteStemWAVHeader(pStemFile, kAudioSampleRate, 0);
+    }
+
+    pConsole->SetAudioOutputBuffer(&audioOutput);
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for(uint32_t frame = 0;frame < frameCount;++frame)
+    {
+        pConsole->BeginAudioFrame();
+        if(pStemFile != nullptr)
+        {
+            pConsole->SetAudioStemBuffer(&stemOutput);
+        }
+
+        pConsole->RunFrame();
+
+        if(pStemFile != nullptr)
+        {
+            fwrite(stemOutput.GetSampleBuffer(), APU_STEM_COUNT * sizeof(float), stemOutput.GetFramesWritten(), pStemFile);
+            stemFrameCount += uint32_t(stemOutput.GetFramesWritten());
+        }
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+
+    // Detach - flushes and pads the final audio frame
+    pConsole->SetAudioOutputBuffer(nullptr);
+    pConsole->SetAudioStemBuffer(nullptr);
+
+    if(pStemFile != nullptr)
+    {
+        FinishStemWAV(pStemFile, kAudioSampleRate, stemFrameCount);
+        printf("stems:      %u frames to %s\n", stemFrameCount, pStemPath);
+    }
+
+    const double seconds = std::chrono::duration<double>(endTime - startTime).count();
+    const double framesPerSecond = seconds > 0.0 ? double(frameCount) / seconds : 0.0;
+
+    printf("frames:     %u\n", frameCount);
+    printf("seconds:    %.3f\n", seconds);
+    printf("fps:        %.1f\n", framesPerSecond);
+    printf("speed:      %.2fx\n", framesPerSecond / 60.0988);
+    printf("idle skip:  %.1f%% of CPU ticks\n", pConsole->GetIdleLoopStats().m_skippedPercent);
+    printf("frame hash: %016llx\n", (unsigned long long)HashBytes(videoOutput.data(), videoOutput.size()));
+
+    pConsole->EjectCartridge();
+    delete pConsole;
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+//
+//  VideoBenchmark.cpp
+//  NES
+//
+//  Palette colour to ARGB conversion on its own - the vector path for this build against the scalar loop
+//  Built with and without AVX2 on x86 (nes-video-bench and nes-video-bench-avx2) so they can be compared
+//  Usage: nes-video-bench [frameCount]
+//
+
+#include "VideoOutput.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+const uint32_t  kDefaultFrameCount  = 20000;
+const uint32_t  kFrameWidth         = 256;
+const uint32_t  kFrameHeight        = 240;
+const uint32_t  kFramePixels        = kFrameWidth * kFrameHeight;
+
+typedef void (*ConvertFunction)(uint32_t* pOut, const uint8_t* pColours, uint32_t count, uint8_t emphasis);
+
+// Whole frames a scanline at a time, the way the PPU hands them over - returns pixels per ns
+static double Measure(ConvertFunction pConvert, uint32_t* pOut, const uint8_t* pColours, uint32_t frameCount)
+{
+    auto startTime = std::chrono::steady_clock::now();
+
+    for(uint32_t frame = 0;frame < frameCount;++frame)
+    {
+        const uint8_t emphasis = uint8_t(frame & 0x7);
+        for(uint32_t line = 0;line < kFrameHeight;++line)
+        {
+            pConvert(&pOut[line * kFrameWidth], &pColours[line * kFrameWidth], kFrameWidth, emphasis);
+        }
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+
+    const double nanoseconds = std::chrono::duration<double>(endTime - startTime).count() * 1e9;
+    return double(kFramePixels) * double(frameCount) / nanoseconds;
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t frameCount = kDefaultFrameCount;
+    if(argc > 1)
+    {
+        frameCount = (uint32_t)strtoul(argv[1], nullptr, 10);
+    }
+
+    // Varied colours including the top bits the PPU never sets, they must be ignored
+    std::vector<uint8_t> colours(kFramePixels);
+    uint32_t seed = 0x12345678;
+    for(uint32_t pixel = 0;pixel < kFramePixels;++pixel)
+    {
+        seed = seed * 1664525 + 1013904223;
+        colours[pixel] = uint8_t(seed >> 24);
+    }
+
+    std::vector<uint32_t> scalarFrame(kFramePixels);
+    std::vector<uint32_t> vectorFrame(kFramePixels);
+
+    // Same result for every emphasis setting and odd run lengths before timing anything
+    for(uint8_t emphasis = 0;emphasis < kVideoEmphasisCount;++emphasis)
+    {
+        for(uint32_t count = 0;count <= 64;++count)
+        {
+            VideoConvertColoursScalar(scalarFrame.data(), colours.data() + count, count, emphasis);
+            VideoConvertColours(vectorFrame.data(), colours.data() + count, count, emphasis);
+
+            if(memcmp(scalarFrame.data(), vectorFrame.data(), count * sizeof(uint32_t)) != 0)
+            {
+                printf("%s conversion differs from scalar - emphasis %u, %u pixels\n", VideoConvertPath(), emphasis, count);
+                return 1;
+            }
+        }
+    }
+
+    const double scalarRate = Measure(VideoConvertColoursScalar, scalarFrame.data(), colours.data(), frameCount);
+    const double vectorRate = Measure(VideoConvertColours, vectorFrame.data(), colours.data(), frameCount);
+
+    printf("frames:             %u\n", frameCount);
+    printf("scalar pixels/ns:   %.3f\n", scalarRate);
+    printf("%-6s pixels/ns:   %.3f\n", VideoConvertPath(), vectorRate);
+    printf("speedup:            %.2fx\n", vectorRate / scalarRate);
+
+    return 0;
+}